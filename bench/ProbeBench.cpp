@@ -0,0 +1,153 @@
+// ----------------------------------------
+// ProbeBench.cpp
+// ----------------------------------------
+// Runs getSystemInfo() against recorded machine fixtures and reports the
+// per-section latency distribution and allocation counts, so probe and
+// parser changes can be measured on any Linux box.
+//
+//   debxray_bench [-n ITERATIONS] FIXTURE_ROOT...
+//   debxray_bench --record DIR      capture this machine's tool output
+//
+// A fixture root mirrors the paths the probes read (sys/, proc/) plus
+// commands/<hash> files holding recorded tool output; record_fixture.sh
+// builds one from a live machine.
+#include "SystemInfo.h"
+#include "ProbeScheduler.h"
+#include "Capabilities.h"
+#include "SysFs.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+
+// ── Allocation counting
+// Every operator new bumps a per-thread counter; the scheduler samples it
+// around each probe task through setProbeAllocationCounter().
+namespace {
+thread_local uint64_t tlsAllocations = 0;
+std::atomic<uint64_t> gAllocations{0};
+
+uint64_t threadAllocations() {
+    return tlsAllocations;
+}
+} // namespace
+
+namespace {
+void* countedAlloc(std::size_t size) {
+    ++tlsAllocations;
+    gAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+} // namespace
+
+void* operator new(std::size_t size) { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+struct Samples {
+    std::vector<double> ms;
+    std::vector<uint64_t> allocs;
+    unsigned timeouts = 0;
+};
+
+double percentile(const std::vector<double>& sorted, double p) {
+    size_t i = std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()));
+    return sorted[i];
+}
+
+void report(const char* label, Samples& s) {
+    if (s.ms.empty()) return;
+    std::sort(s.ms.begin(), s.ms.end());
+    double allocMean = 0;
+    for (uint64_t a : s.allocs) allocMean += a;
+    allocMean /= s.allocs.empty() ? 1 : s.allocs.size();
+    std::printf("  %-10s %9.3f %9.3f %9.3f %9.3f %9.3f %10.1f %5u\n",
+                label, s.ms.front(), percentile(s.ms, 0.50), percentile(s.ms, 0.90),
+                percentile(s.ms, 0.99), s.ms.back(), allocMean, s.timeouts);
+}
+
+int runFixture(const std::string& root, int iterations) {
+    struct stat st;
+    if (::stat(root.c_str(), &st) != 0 || !S_ISDIR(st.st_mode)) {
+        std::fprintf(stderr, "debxray_bench: %s is not a directory\n", root.c_str());
+        return 1;
+    }
+    setSysRoot(root);
+    rescanCapabilities();
+
+    SystemInfo warm = getSystemInfo();
+    std::printf("%s\n  %s | %s %s | %s | %s | battery %s | %zu drive(s)\n", root.c_str(),
+                warm.model.c_str(), warm.cpuBrand.c_str(), warm.cpuModel.c_str(), warm.gpu.c_str(),
+                warm.resolution.c_str(), warm.battery.c_str(), warm.detectedDrives.size());
+
+    std::map<std::string, Samples> sections;
+    Samples total;
+    for (int i = 0; i < iterations; ++i) {
+        uint64_t allocsBefore = gAllocations.load(std::memory_order_relaxed);
+        auto t0 = std::chrono::steady_clock::now();
+        SystemInfo info = getSystemInfo();
+        auto t1 = std::chrono::steady_clock::now();
+
+        total.ms.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+        total.allocs.push_back(gAllocations.load(std::memory_order_relaxed) - allocsBefore);
+        for (const auto& t : info.timings) {
+            Samples& s = sections[t.section];
+            s.ms.push_back(t.wallMs);
+            s.allocs.push_back(t.allocations);
+            s.timeouts += t.timedOut;
+        }
+    }
+
+    std::printf("  %-10s %9s %9s %9s %9s %9s %10s %5s\n",
+                "section", "min ms", "p50", "p90", "p99", "max", "allocs", "t/o");
+    for (auto& [name, s] : sections) report(name.c_str(), s);
+    report("total", total);
+    return 0;
+}
+
+int record(const std::string& dir) {
+    std::string commands = dir + "/commands";
+    ::mkdir(dir.c_str(), 0755);
+    ::mkdir(commands.c_str(), 0755);
+    setCommandRecordDir(commands);
+    getSystemInfo();
+    std::printf("Recorded tool output in %s\n", commands.c_str());
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int iterations = 2000;
+    std::vector<std::string> roots;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--record" && i + 1 < argc) return record(argv[++i]);
+        if (arg == "-n" && i + 1 < argc)       iterations = std::max(1, std::atoi(argv[++i]));
+        else                                   roots.push_back(arg);
+    }
+    if (roots.empty()) {
+        std::fprintf(stderr, "usage: debxray_bench [-n ITERATIONS] FIXTURE_ROOT...\n"
+                             "       debxray_bench --record DIR\n");
+        return 2;
+    }
+
+    setProbeAllocationCounter(threadAllocations);
+    int rc = 0;
+    for (const auto& root : roots) rc |= runFixture(root, iterations);
+    return rc;
+}
@@ -0,0 +1,74 @@
+#!/usr/bin/env bash
+# Captures the files debXray's probes read into a fixture root for
+# debxray_bench. Run as root on the machine to capture (the DMI table and
+# serials are root-only):
+#
+#   sudo bench/record_fixture.sh fixtures/<model> [path/to/debxray_bench]
+set -euo pipefail
+
+OUT=${1:?usage: record_fixture.sh OUT_DIR [debxray_bench]}
+BENCH=${2:-}
+mkdir -p "$OUT"
+
+# copy FILE... — regular files only, keeping their absolute path under $OUT
+copy() {
+    for f in "$@"; do
+        [ -f "$f" ] && [ -r "$f" ] || continue
+        mkdir -p "$OUT$(dirname "$f")"
+        cat "$f" > "$OUT$f" 2>/dev/null || rm -f "$OUT$f"
+    done
+}
+
+copy /proc/cpuinfo /proc/meminfo /proc/device-tree/model
+copy /sys/firmware/dmi/tables/DMI /sys/firmware/dmi/tables/smbios_entry_point
+copy /sys/class/dmi/id/*
+copy /sys/bus/pci/devices/*/uevent
+copy /sys/class/drm/*/status /sys/class/drm/*/enabled /sys/class/drm/*/edid
+copy /sys/class/power_supply/*/type /sys/class/power_supply/*/uevent
+copy /sys/devices/system/cpu/cpu[0-9]*/topology/physical_package_id
+[ -d /sys/class/nvme ] && mkdir -p "$OUT/sys/class/nvme"
+
+# SCSI transport classes decide each disk's TRAN; only their presence
+# matters, plus the scsi_host driver name and FC symbolic name.
+copy /sys/class/scsi_host/*/proc_name /sys/class/fc_host/*/symbolic_name
+for cls in spi_host fc_host sas_host iscsi_host spi_transport fc_transport; do
+    for entry in /sys/class/$cls/*; do
+        [ -e "$entry" ] && mkdir -p "$OUT$entry"
+    done
+done
+for dev in /sys/bus/scsi/devices/*; do
+    for attr in sas_device ieee1394_id; do
+        [ -e "$dev/$attr" ] && mkdir -p "$OUT$dev/$attr"
+    done
+done
+
+# /sys/block/X is a symlink whose target encodes the bus; recreate it as a
+# relative link into a copied device directory.
+for link in /sys/block/*; do
+    name=$(basename "$link")
+    target=$(readlink -f "$link")
+    mkdir -p "$OUT$target/queue" "$OUT$target/device"
+    for attr in size removable queue/rotational device/model device/name; do
+        [ -r "$link/$attr" ] && cat "$link/$attr" > "$OUT$target/$attr" 2>/dev/null || true
+    done
+    mkdir -p "$OUT/sys/block"
+    ln -sfn "$(realpath --relative-to="$OUT/sys/block" "$OUT$target")" "$OUT/sys/block/$name"
+done
+
+# Fallback tools present on this machine; the probes check for them on PATH.
+for tool in dmidecode screenfetch xdpyinfo xrandr; do
+    path=$(command -v "$tool" 2>/dev/null || true)
+    [ -z "$path" ] && [ -x "/usr/sbin/$tool" ] && path=/usr/sbin/$tool
+    [ -n "$path" ] || continue
+    mkdir -p "$OUT$(dirname "$path")"
+    : > "$OUT$path"
+    chmod +x "$OUT$path"
+done
+
+# Tool output is keyed by a hash of the exact command line, so let the
+# probes record it themselves.
+if [ -n "$BENCH" ]; then
+    "$BENCH" --record "$OUT"
+fi
+
+echo "[+] Fixture written to $OUT"
@@ -0,0 +1,30 @@
+// ----------------------------------------
+// BlockDevices.h
+// ----------------------------------------
+// Native block-device enumeration over /sys/block, replacing `lsblk`.
+// The transport is derived from the device's sysfs ancestry the same way
+// lsblk's TRAN column is, so drive gating behaves identically without
+// spawning a process. Cheap enough to call repeatedly for re-checks.
+#pragma once
+#include <string>
+#include <vector>
+
+struct BlockDevice {
+    std::string name;            // kernel name, e.g. "sda", "nvme0n1"
+    std::string tran;            // lsblk TRAN: "sata", "ata", "usb", "nvme", "sas", "spi", ...;
+                                 // "scsi" for an unclassified SCSI host, "" for no bus
+    std::string model;           // trimmed, "" if the device doesn't report one
+    unsigned long long sizeBytes = 0;
+    bool rotational = false;
+    bool removable = false;
+};
+
+// Whole disks only (no partitions); loop, ram, zram and optical (sr)
+// devices are skipped.
+std::vector<BlockDevice> enumerateBlockDevices(const std::string& root = "/sys/block");
+
+// Transport for a resolved sysfs device path, e.g.
+// /sys/devices/pci0000:00/0000:00:14.0/usb2/.../block/sdb → "usb".
+// SCSI disks are classified by their host's transport class
+// (/sys/class/{spi,fc,sas,iscsi}_host) and scsi_host proc_name.
+std::string blockTransport(const std::string& name, const std::string& devicePath);
@@ -0,0 +1,41 @@
+// ----------------------------------------
+// Capabilities.h
+// ----------------------------------------
+// What this machine can answer natively and which external tools exist,
+// decided once from cheap access()/stat() checks. Probes consult it to
+// take the fastest source that's actually there and to skip tools that
+// aren't, and the installer uses it to fetch only packages that fill a
+// real gap.
+#pragma once
+#include <cstdint>
+#include <string>
+
+enum class Capability {
+    // Native sources
+    SmbiosTables,   // /sys/firmware/dmi/tables (root)
+    DmiSysfs,       // /sys/class/dmi/id
+    PciSysfs,       // /sys/bus/pci/devices
+    DrmEdid,        // a /sys/class/drm connector with an EDID
+    PowerSupply,    // /sys/class/power_supply
+    BlockSysfs,     // /sys/block
+    // External tools, found on PATH
+    Dmidecode,
+    Screenfetch,
+    Xdpyinfo,
+    Xrandr,
+    Count
+};
+
+const char* capabilityName(Capability cap);
+
+// Computed on first use; thread-safe.
+bool hasCapability(Capability cap);
+
+// Re-runs the checks, e.g. after installing packages.
+void rescanCapabilities();
+
+// "smbios dmi pci ... | tools: dmidecode xrandr" for the log.
+std::string describeCapabilities();
+
+// Absolute path of `tool` on PATH, or "" if it isn't installed.
+std::string findOnPath(const char* tool);
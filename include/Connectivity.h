@@ -0,0 +1,44 @@
+// ----------------------------------------
+// Connectivity.h
+// ----------------------------------------
+#pragma once
+#include <chrono>
+#include <memory>
+#include <string>
+
+enum class LinkStatus { Unknown, Online, Offline };
+
+const char* linkStatusName(LinkStatus status);
+
+// Resolves host and opens a TCP connection to it, giving up once
+// `timeout` has elapsed across resolution and all resolved addresses.
+// Works on networks that drop ICMP, and proves the port we actually
+// upload to is open. If the resolver stalls past the deadline, the last
+// addresses it returned for host:port are tried instead.
+bool canReach(const std::string& host, const std::string& port, std::chrono::milliseconds timeout);
+
+// Re-checks reachability on a background thread and publishes the result
+// as a lock-free status, so the UI and upload path always see the current
+// link state without ever blocking on the network themselves.
+class ConnectivityMonitor {
+public:
+    explicit ConnectivityMonitor(std::string host, std::string port = "443",
+                                 std::chrono::milliseconds timeout = std::chrono::milliseconds(1500),
+                                 std::chrono::milliseconds interval = std::chrono::seconds(10));
+    ~ConnectivityMonitor();
+
+    void start();
+
+    LinkStatus status() const;
+
+    // Checks again now instead of waiting out the interval.
+    void recheck();
+
+private:
+    struct State;
+    std::shared_ptr<State> state;   // shared with the monitor thread
+    std::string host;
+    std::string port;
+    std::chrono::milliseconds timeout;
+    std::chrono::milliseconds interval;
+};
@@ -0,0 +1,199 @@
+// ----------------------------------------
+// CpuInfo.h
+// ----------------------------------------
+// CPU identification without lscpu or std::regex: the brand string comes
+// straight from CPUID (or /proc/cpuinfo off x86) and is split by a small
+// hand-written scanner.
+#pragma once
+#include <string>
+#include <string_view>
+
+struct CpuName {
+    std::string brand = "Unknown";   // e.g. "Intel Core i7"
+    std::string model = "Unknown";   // e.g. "8650U"
+    std::string speed = "Unknown";   // e.g. "1.90" (GHz)
+};
+
+// Raw brand string, e.g. "Intel(R) Core(TM) i7-8650U CPU @ 1.90GHz".
+std::string readCpuBrandString();
+
+CpuName parseCpuName(std::string_view brandString);
+
+// ── Scanner internals, constexpr so whole parses can be pinned at compile time.
+
+struct CpuNameSpans {
+    std::string_view head;       // brand string minus the "@ x.xxGHz" tail
+    std::string_view speed;      // "1.90", empty if absent
+    std::string_view model;      // e.g. "8650U", "N3060", "2680 v4"; empty if absent
+    size_t modelPos = std::string_view::npos;   // offset of `model` in `head`
+};
+
+constexpr bool cpuIsDigit(char c) { return c >= '0' && c <= '9'; }
+constexpr bool cpuIsAlpha(char c) { return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z'); }
+constexpr bool cpuIsUpper(char c) { return c >= 'A' && c <= 'Z'; }
+constexpr bool cpuIsSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+constexpr std::string_view cpuTrimRight(std::string_view s) {
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\n' || s.back() == '\r'))
+        s.remove_suffix(1);
+    return s;
+}
+
+constexpr std::string_view cpuTrim(std::string_view s) {
+    while (!s.empty() && cpuIsSpace(s.front())) s.remove_prefix(1);
+    while (!s.empty() && cpuIsSpace(s.back())) s.remove_suffix(1);
+    return s;
+}
+
+constexpr CpuNameSpans splitCpuName(std::string_view s) {
+    CpuNameSpans out;
+    out.head = s;
+
+    // "@ <digits/dots>GHz" — the first '@' that forms a full match wins.
+    for (size_t at = s.find('@'); at != std::string_view::npos; at = s.find('@', at + 1)) {
+        size_t b = at + 1;
+        while (b < s.size() && cpuIsSpace(s[b])) ++b;
+        size_t e = b;
+        while (e < s.size() && (cpuIsDigit(s[e]) || s[e] == '.')) ++e;
+        if (e > b && s.substr(e, 3) == "GHz") {
+            out.speed = s.substr(b, e - b);
+            out.head  = cpuTrimRight(s.substr(0, at));
+            break;
+        }
+    }
+
+    // Leftmost run of at least four digits: keep up to five, then up to
+    // two letters ("8650U", "5800X", "10700", "1165G"). A lone capital
+    // word-initial letter in front is the series ("N3060", "G4560"), and a
+    // " v4"-style revision after it belongs to the model too ("2680 v4").
+    std::string_view h = out.head;
+    for (size_t p = 0; p + 4 <= h.size(); ++p) {
+        if (!(cpuIsDigit(h[p]) && cpuIsDigit(h[p + 1]) && cpuIsDigit(h[p + 2]) && cpuIsDigit(h[p + 3])))
+            continue;
+        size_t e = p + 4;
+        if (e < h.size() && cpuIsDigit(h[e])) ++e;
+        for (int letters = 0; letters < 2 && e < h.size() && cpuIsAlpha(h[e]); ++letters) ++e;
+        if (e + 2 < h.size() && h[e] == ' ' && h[e + 1] == 'v' && cpuIsDigit(h[e + 2])) {
+            e += 3;
+            while (e < h.size() && cpuIsDigit(h[e])) ++e;
+        }
+        if (p >= 1 && cpuIsUpper(h[p - 1]) && (p == 1 || h[p - 2] == ' ')) --p;
+        out.model    = h.substr(p, e - p);
+        out.modelPos = p;
+        break;
+    }
+    return out;
+}
+
+// Marketing words dropped from names, matched case-insensitively as whole
+// words. "(R)", "(TM)" and other parenthesised marks, "<N>-Core" counts
+// and "<N>th Gen" prefixes are dropped by cpuNoiseAt() too, and so is
+// everything from an integrated-graphics tail ("with Radeon Graphics")
+// to the end.
+constexpr std::string_view kCpuNameNoise[] = { "CPU", "Processor", "APU" };
+constexpr std::string_view kCpuNameTails[] = { "with Radeon", "w/ Radeon" };
+
+constexpr bool cpuMatchNoCase(std::string_view s, size_t pos, std::string_view word) {
+    if (pos + word.size() > s.size()) return false;
+    for (size_t i = 0; i < word.size(); ++i) {
+        char a = s[pos + i], b = word[i];
+        if (a >= 'A' && a <= 'Z') a = static_cast<char>(a - 'A' + 'a');
+        if (b >= 'A' && b <= 'Z') b = static_cast<char>(b - 'A' + 'a');
+        if (a != b) return false;
+    }
+    return true;
+}
+
+constexpr bool cpuWordEdge(std::string_view s, size_t pos) {
+    return pos == 0 || pos >= s.size() || !(cpuIsAlpha(s[pos]) && cpuIsAlpha(s[pos - 1]));
+}
+
+// Length of the noise token starting at `pos`, 0 if there is none.
+constexpr size_t cpuNoiseAt(std::string_view s, size_t pos) {
+    if (s[pos] == '(') {
+        size_t close = s.find(')', pos + 1);
+        if (close != std::string_view::npos) return close + 1 - pos;
+    }
+    if (pos > 0 && (cpuIsAlpha(s[pos - 1]) || cpuIsDigit(s[pos - 1]))) return 0;
+
+    for (std::string_view tail : kCpuNameTails) {
+        if (cpuMatchNoCase(s, pos, tail)) return s.size() - pos;
+    }
+    for (std::string_view word : kCpuNameNoise) {
+        if (cpuMatchNoCase(s, pos, word) && cpuWordEdge(s, pos + word.size())) return word.size();
+    }
+
+    size_t e = pos;
+    while (e < s.size() && cpuIsDigit(s[e])) ++e;
+    if (e == pos) return 0;
+    if (cpuMatchNoCase(s, e, "-Core")) {
+        e += 5;
+        if (e < s.size() && s[e] == 's') ++e;
+        return cpuWordEdge(s, e) ? e - pos : 0;
+    }
+    for (std::string_view ordinal : { "th Gen", "st Gen", "nd Gen", "rd Gen" }) {
+        if (cpuMatchNoCase(s, e, ordinal) && cpuWordEdge(s, e + ordinal.size())) return e + ordinal.size() - pos;
+    }
+    return 0;
+}
+
+// Bounded, allocation-free text so the cleaned names can be constexpr.
+struct CpuText {
+    char data[64] = {};
+    size_t len = 0;
+    constexpr std::string_view view() const { return std::string_view(data, len); }
+};
+
+// "Intel(R) Core(TM) i7-" → "Intel Core i7": noise dropped, whitespace
+// collapsed, trailing separators trimmed.
+constexpr CpuText cpuCleanName(std::string_view s) {
+    CpuText out;
+    for (size_t i = 0; i < s.size() && out.len < sizeof(out.data);) {
+        if (size_t n = cpuNoiseAt(s, i)) {
+            i += n;
+            continue;
+        }
+        char c = s[i++];
+        if (cpuIsSpace(c)) {
+            if (out.len == 0 || out.data[out.len - 1] == ' ') continue;
+            c = ' ';
+        }
+        out.data[out.len++] = c;
+    }
+    while (out.len > 0 && (out.data[out.len - 1] == ' ' || out.data[out.len - 1] == '-')) --out.len;
+    return out;
+}
+
+constexpr CpuText cpuCopy(std::string_view s) {
+    CpuText out;
+    for (char c : s) {
+        if (out.len == sizeof(out.data)) break;
+        out.data[out.len++] = c;
+    }
+    return out;
+}
+
+// parseCpuName() without the std::strings; empty parts are unknown.
+struct CpuNameParts {
+    CpuText brand;              // e.g. "Intel Core i7"
+    CpuText model;              // e.g. "8650U"; the cleaned name if no model number
+    std::string_view speed;     // e.g. "1.90"
+};
+
+constexpr CpuNameParts parseCpuNameParts(std::string_view brandString) {
+    CpuNameParts out;
+    std::string_view line = cpuTrim(brandString);
+    if (line.empty()) return out;
+
+    CpuNameSpans spans = splitCpuName(line);
+    out.speed = spans.speed;
+    if (spans.model.empty()) {
+        out.model = cpuCleanName(spans.head);
+        return out;
+    }
+    out.model = cpuCopy(spans.model);
+    if (spans.modelPos > 0) out.brand = cpuCleanName(spans.head.substr(0, spans.modelPos));
+    return out;
+}
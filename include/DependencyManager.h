@@ -1,4 +1,38 @@
 #pragma once
-bool isOnline();
+#include <memory>
+#include <string>
+#include <vector>
+
 bool isRoot();
-void installDependencies();
\ No newline at end of file
+
+// Packages for fallback tools that are missing where no native source
+// covers them either. Empty on any machine with sysfs DMI/PCI/DRM, so an
+// offline image never needs the package manager.
+std::vector<std::string> missingDependencies();
+
+// Installs packages with apt-get on a background thread. apt's output is
+// streamed into the log, and its status lines drive a progress value the
+// UI can draw, so a slow mirror never freezes the window. apt runs as our
+// child on a pipe, so the process must not exit while isBusy(): dpkg
+// killed mid-configure leaves packages half-installed.
+class DependencyInstaller {
+public:
+    enum class Phase { Idle, Updating, Installing, Done, Failed };
+
+    DependencyInstaller();
+
+    void start(std::vector<std::string> packages);
+
+    Phase phase() const;
+    bool isBusy() const;
+    float progress() const;         // 0..1 across update + install
+    std::string action() const;     // apt's latest status message
+
+    // True once after a run finishes; `installed` receives the requested
+    // packages that dpkg now lists as installed.
+    bool takeFinished(std::vector<std::string>& installed);
+
+private:
+    struct State;
+    std::shared_ptr<State> state;   // shared with the install thread
+};
@@ -0,0 +1,45 @@
+// ----------------------------------------
+// DpkgStatus.h
+// ----------------------------------------
+// Installed-package set read straight from dpkg's database, so "is X
+// installed?" is a hash lookup instead of a fork/exec of `dpkg -s`.
+#pragma once
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <sys/types.h>
+#include <unordered_set>
+
+class DpkgStatus {
+public:
+    // Loaded on first use; safe to query from any thread.
+    static DpkgStatus& instance();
+
+    bool isInstalled(std::string_view package);
+
+    // False off Debian (no status file), where isInstalled() knows nothing.
+    bool hasDatabase();
+
+    // Re-scans the database if it changed since the last scan (e.g. after
+    // apt-get install). Cheap when nothing changed: one stat().
+    void reload();
+
+    DpkgStatus(const DpkgStatus&) = delete;
+    DpkgStatus& operator=(const DpkgStatus&) = delete;
+
+private:
+    explicit DpkgStatus(std::string path = "/var/lib/dpkg/status");
+    void scan();    // caller holds m
+
+    std::string path;
+    std::mutex m;
+    std::unordered_set<std::string> installed;
+    // Identity of the last scanned file. dpkg replaces it by rename, so
+    // the inode changes even when size and mtime happen to match.
+    ino_t  statIno   = 0;
+    off_t  statSize  = -1;
+    time_t statMtime = 0;
+};
+
+// Shorthand for DpkgStatus::instance().isInstalled(package).
+bool isPackageInstalled(std::string_view package);
@@ -0,0 +1,35 @@
+// ----------------------------------------
+// Edid.h
+// ----------------------------------------
+// Native display probe over /sys/class/drm/*/edid. Works on KMS-only
+// images with no X server, replacing `xdpyinfo` and `xrandr --verbose`.
+#pragma once
+#include <string>
+#include <vector>
+
+struct DisplayOutput {
+    std::string connector;       // e.g. "eDP-1", "HDMI-A-1"
+    std::string status;          // "connected", "disconnected", "unknown", or "cached" (probe cache)
+    bool enabled = false;
+    bool internal = false;       // eDP / LVDS / DSI panel
+
+    std::string vendor;          // PNP id, e.g. "AUO", "BOE", "DEL"
+    unsigned productCode = 0;
+    std::string name;            // monitor name or panel model string
+
+    int nativeWidth = 0;         // preferred (first detailed) timing
+    int nativeHeight = 0;
+    double refreshHz = 0.0;
+
+    int widthMm = 0;             // physical image size
+    int heightMm = 0;
+
+    std::string resolution() const;   // "1920x1080", "" if unknown
+    double diagonalInches() const;    // 0 if size unknown
+};
+
+// Decodes a base EDID block (128 bytes; extensions are ignored).
+bool parseEdid(const unsigned char* data, size_t size, DisplayOutput& out);
+
+// Connected outputs with a readable EDID, internal panels first.
+std::vector<DisplayOutput> enumerateDisplays(const std::string& root = "/sys/class/drm");
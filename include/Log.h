@@ -1,7 +1,102 @@
 #pragma once
+#include <chrono>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
+// Human log prefixes: [*] Info, [+] Success, [-] Warning, [!] Error.
+enum class LogLevel : uint8_t { Info, Success, Warning, Error, Count };
+
+// Subsystem a record came from. External covers lines appended to the
+// log file by other programs.
+enum class LogSource : uint8_t { App, Probe, Network, Packages, Cache, Webcam, External, Count };
+
+const char* logLevelName(LogLevel level);
+const char* logSourceName(LogSource source);
+
+// Optional key/value detail; values are preformatted.
+using LogFields = std::vector<std::pair<std::string, std::string>>;
+
+// Lines kept in memory for the log viewer; older ones are only in the file.
+constexpr size_t kLogRingCapacity = 8192;
+
 void clearLog();
+
+// Queues a record for the background writer and returns; safe from any
+// thread. It reaches /tmp/debxray.log (human) and /tmp/debxray.jsonl
+// (one JSON object per line) within ~50 ms, in order.
+void logRecord(LogLevel level, LogSource source, std::string message, LogFields fields = {});
+
+// Compatibility shim for callers that predate typed records: the level
+// comes from a leading "[*]"/"[+]"/"[-]"/"[!]" (which is stripped), the
+// source is App. New code calls logRecord() instead.
 void logMessage(const std::string& message);
-std::vector<std::string> readLogTail(int maxLines = 100);
\ No newline at end of file
+
+// Blocks until everything logged so far is written and synced. Runs at
+// exit too, so only a crash can lose queued lines.
+void flushLog();
+
+// One typed log entry, as the viewer indexes it. Our own come straight
+// from logRecord(); a line another process appended to the log file
+// becomes a record with source External, the whole line as its message,
+// and a level only if the line carries one of our markers.
+struct LogRecord {
+    std::chrono::system_clock::time_point when;
+    LogLevel level = LogLevel::Info;
+    LogSource source = LogSource::App;
+    std::string message;
+    LogFields fields;
+};
+
+// Which records the viewer wants: bit N of `levels` is LogLevel N, bit N
+// of `sources` is LogSource N.
+struct LogFilter {
+    uint32_t levels = ~0u;
+    uint32_t sources = ~0u;
+
+    bool matches(const LogRecord& record) const {
+        return (levels >> static_cast<unsigned>(record.level) & 1u) &&
+               (sources >> static_cast<unsigned>(record.source) & 1u);
+    }
+};
+
+// The log viewer's window onto the in-memory ring: the sequence numbers
+// of the records that pass a filter and contain a search string. Our own
+// records are added, typed, by the log writer as it renders them, and
+// lines other processes append to the log file arrive from a background
+// LogTail as the External source; the viewer itself never touches the
+// file, and never re-parses our own lines.
+// update() only scans lines added since the last call. A query that
+// extends the previous one re-tests the current matches instead of the
+// whole ring; each line keeps a lower-cased copy for searching.
+// UI thread only.
+class LogView {
+public:
+    void setFilter(const LogFilter& filter);
+    void setQuery(std::string_view query);  // case-insensitive substring
+
+    // Picks up new lines (including other processes' writes), drops those
+    // that fell out of the ring, and applies any filter or query change.
+    // Cheap when nothing changed.
+    void update();
+
+    size_t size() const { return rows.size(); }
+    size_t totalLines() const { return total; }
+
+    // Text of matches [first, last) into `lines`, reusing its strings, so
+    // only the rows on screen are copied.
+    void copyRows(size_t first, size_t last, std::vector<std::string>& lines) const;
+
+private:
+    enum class Pending { None, Narrow, Rebuild };
+
+    LogFilter filter;
+    std::string query;              // lower-cased
+    std::vector<uint64_t> rows;     // matching sequence numbers, ascending
+    uint64_t seenSeq = 0;           // lines before this already considered
+    size_t total = 0;
+    uint64_t seenClears = ~0ull;    // clearLog() count rows are based on
+    Pending pending = Pending::Rebuild;
+};
@@ -0,0 +1,50 @@
+// ----------------------------------------
+// LogTail.h
+// ----------------------------------------
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <sys/types.h>
+
+// Byte ranges of the log file that this process appended itself. The
+// writer records each append under `m` before releasing it, so the tail
+// never sees our own bytes without knowing they are ours.
+struct OwnedRanges {
+    std::mutex m;
+    ino_t ino = 0;                                  // file the ranges refer to
+    std::vector<std::pair<off_t, off_t>> ranges;    // [begin, end), ascending
+    uint64_t truncations = 0;                       // bumped by clearLog()
+
+    void add(off_t begin, off_t end) {  // caller holds `m`
+        if (!ranges.empty() && ranges.back().second == begin) ranges.back().second = end;
+        else ranges.emplace_back(begin, end);
+    }
+};
+
+// Follows a log file that other processes (apt output, wipe scripts)
+// append to alongside our own writer. A background thread wakes on
+// inotify, reads only the bytes appended since last time, skips the
+// ranges this process wrote, and hands each complete foreign line to
+// `onLine`. Our own records never round-trip through the file; the
+// viewer gets them from memory. Truncation and replacement of the file
+// start the offset over.
+class LogTail {
+public:
+    using LineHandler = std::function<void(std::string_view line)>;
+
+    LogTail(std::string path, std::shared_ptr<OwnedRanges> owned, LineHandler onLine);
+    ~LogTail();
+
+    void start();
+
+private:
+    struct State;
+    std::shared_ptr<State> state;   // shared with the tail thread
+    std::string path;
+};
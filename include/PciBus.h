@@ -0,0 +1,69 @@
+// ----------------------------------------
+// PciBus.h
+// ----------------------------------------
+// Native PCI enumeration over /sys/bus/pci/devices, with vendor/device
+// names resolved through a compact hash index built from pci.ids and
+// memory-mapped on later runs. Replaces the separate `lspci` pipelines.
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Class/subclass pairs (upper 16 bits of the 24-bit class code).
+enum PciClass : uint16_t {
+    PciClassScsi      = 0x0100,
+    PciClassIde       = 0x0101,
+    PciClassRaid      = 0x0104,
+    PciClassSata      = 0x0106,
+    PciClassSas       = 0x0107,
+    PciClassNvm       = 0x0108,
+    PciClassEthernet  = 0x0200,
+    PciClassNetwork   = 0x0280,
+    PciClassVga       = 0x0300,
+    PciClass3D        = 0x0302,
+    PciClassDisplay   = 0x0380,
+    PciClassAudio     = 0x0401,
+    PciClassHdAudio   = 0x0403,
+};
+
+struct PciDevice {
+    std::string slot;            // e.g. "0000:00:02.0"
+    uint32_t classCode = 0;      // 24-bit class code, e.g. 0x030000
+    uint16_t vendorId = 0;
+    uint16_t deviceId = 0;
+    std::string driver;          // bound kernel driver, "" if none
+    std::string vendorName;      // from pci.ids, "" if unknown
+    std::string deviceName;
+
+    uint16_t pciClass() const { return static_cast<uint16_t>(classCode >> 8); }
+
+    // "Vendor Device", falling back to "[vvvv:dddd]" for unknown IDs.
+    std::string displayName() const;
+};
+
+// All functions on the bus, sorted by slot.
+std::vector<PciDevice> enumeratePci(const std::string& root = "/sys/bus/pci/devices");
+
+// Name lookup over pci.ids. The first run builds a binary hash index in
+// /var/cache/debxray (rebuilt when pci.ids changes); later runs just mmap
+// it. On a read-only image the index is built in memory instead.
+class PciIds {
+public:
+    static const PciIds& instance();
+
+    std::string vendor(uint16_t vendorId) const;
+    std::string device(uint16_t vendorId, uint16_t deviceId) const;
+
+    PciIds(const PciIds&) = delete;
+    PciIds& operator=(const PciIds&) = delete;
+    ~PciIds();
+
+private:
+    PciIds();
+    const char* lookup(uint32_t key) const;
+
+    const unsigned char* map = nullptr;   // mmap'd index, or owned.data()
+    size_t mapSize = 0;
+    bool mapped = false;
+    std::vector<unsigned char> owned;
+};
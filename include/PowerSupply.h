@@ -0,0 +1,37 @@
+// ----------------------------------------
+// PowerSupply.h
+// ----------------------------------------
+// Native battery probe over /sys/class/power_supply. Reads the same
+// attributes upowerd does, without needing the daemon (or the upower
+// CLI) to be present.
+#pragma once
+#include <string>
+#include <vector>
+
+struct BatteryInfo {
+    std::string name;            // e.g. "BAT0"
+    std::string manufacturer;
+    std::string model;
+    std::string status;          // "Charging", "Discharging", "Full", ...
+
+    // Either energy_* (µWh) or charge_* (µAh), whichever the firmware
+    // exposes; `chargeUnits` says which. Ratios are unit-independent.
+    double full = 0.0;
+    double fullDesign = 0.0;
+    bool chargeUnits = false;
+
+    long cycleCount = -1;        // -1 if not reported
+    int chargePercent = -1;      // current charge, -1 if not reported
+
+    // full / fullDesign in percent, -1 if unknown.
+    double healthPercent() const;
+};
+
+// System batteries only; peripheral batteries (scope=Device) are skipped.
+std::vector<BatteryInfo> enumerateBatteries(const std::string& root = "/sys/class/power_supply");
+
+// Combined wear across all batteries in percent, -1 if unknown.
+double combinedBatteryHealth(const std::vector<BatteryInfo>& batteries);
+
+// "Excellent" (>= 90%), "Good" (>= 70%), "Poor", or "N/A" if unknown.
+std::string gradeBatteryHealth(double healthPercent);
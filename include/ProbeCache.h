@@ -0,0 +1,41 @@
+// ----------------------------------------
+// ProbeCache.h
+// ----------------------------------------
+// On-disk cache of the probe sections that rarely change between boots of
+// the same machine, keyed by SMBIOS system UUID + serial. Units are often
+// rebooted into debXray several times; with a cache hit those sections
+// are shown at once, while the volatile ones (drives, RAM, battery, ...)
+// are probed. The cached sections are then re-probed in the background,
+// since parts do get swapped (and boards reflashed with the same serial);
+// live results replace the cached ones and update the entry.
+#pragma once
+#include "SystemInfo.h"
+#include <string>
+
+// CPU parse, GPU name and PCI device list. Displays are always probed
+// live (monitors come and go); only the internal panel's EDID is kept.
+constexpr ProbeMask kCachedSections = probeBit(ProbeSection::Cpu) | probeBit(ProbeSection::Gpu) |
+                                      probeBit(ProbeSection::Pci);
+
+// "<uuid>/<serial>", or "" if the firmware doesn't identify the machine
+// (no root, or placeholder values) — in which case nothing is cached.
+std::string machineCacheKey();
+
+// Fills the kCachedSections fields of `info` from the entry for `key`,
+// and `panel` with the cached internal panel (connector "" if none).
+bool loadProbeCache(const std::string& key, SystemInfo& info, DisplayOutput& panel);
+
+// True if the kCachedSections fields of `a` and `b` match.
+bool sameCachedFields(const SystemInfo& a, const SystemInfo& b);
+
+// When the live Display probe found no internal panel (lid shut, panel
+// powered down), lists the cached one first and takes the resolution and
+// screen size from it.
+void applyCachedPanel(SystemInfo& info, const DisplayOutput& panel);
+
+// Stores the kCachedSections fields of `info` and its internal panel's
+// EDID under `key`. Skipped unless every cached section finished cleanly
+// (not timed out, failed, disabled or unprivileged), so a default or
+// partial answer is never remembered; the file is only rewritten when the
+// entry changed.
+void saveProbeCache(const std::string& key, const SystemInfo& info);
@@ -0,0 +1,84 @@
+// ----------------------------------------
+// ProbeRegistry.h
+// ----------------------------------------
+// Each probe is a registered descriptor: which section (and so which
+// SystemInfo fields) it fills, what it costs, what must settle before it,
+// and whether it needs root. refreshSystemInfo() schedules whatever is
+// registered — critical and cheap probes first — so adding or reordering
+// a probe is one registration, not an edit to the runner. Probes are keyed
+// by ProbeSection, so a registration replaces or reorders a section's
+// probe; a brand-new section starts in SystemInfo.h.
+#pragma once
+#include "SystemInfo.h"
+#include "Smbios.h"
+#include "PciBus.h"
+#include "BlockDevices.h"
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+// Data shared by several probes within one snapshot, decoded at most once
+// by whichever probe asks first. Held by shared_ptr so an abandoned probe
+// can still use it after the pass returns.
+struct ProbeContext {
+    const SmbiosInfo* smbios() {
+        std::call_once(smbiosOnce, [this] { smbiosOk = readSmbios(smbiosData); });
+        return smbiosOk ? &smbiosData : nullptr;
+    }
+
+    const std::vector<PciDevice>& pci() {
+        std::call_once(pciOnce, [this] { pciData = enumeratePci(); });
+        return pciData;
+    }
+
+    const std::vector<BlockDevice>& blockDevices() {
+        std::call_once(blockOnce, [this] { blockData = enumerateBlockDevices(); });
+        return blockData;
+    }
+
+private:
+    std::once_flag smbiosOnce;
+    SmbiosInfo smbiosData;
+    bool smbiosOk = false;
+
+    std::once_flag pciOnce;
+    std::vector<PciDevice> pciData;
+
+    std::once_flag blockOnce;
+    std::vector<BlockDevice> blockData;
+};
+
+// Typical cost on the native path; drives run order, not deadlines.
+enum class ProbeCost { Cheap, Moderate, Expensive };
+
+struct ProbeDescriptor {
+    ProbeSection section = ProbeSection::Count;
+    const char* fields = "";            // SystemInfo fields it owns, for docs/diagnostics
+    ProbeCost cost = ProbeCost::Cheap;
+    std::chrono::milliseconds deadline{3000};
+    ProbeMask dependsOn = 0;            // sections that must settle first
+    bool needsRoot = false;             // full results only as root
+    bool critical = false;              // the UI gates on it (drive check)
+
+    std::function<void(ProbeContext& ctx, SystemInfo& partial)> run;
+    std::function<void(SystemInfo& out, const SystemInfo& partial)> merge;
+};
+
+// Adds (or replaces, by section) a probe. Call before the first pass.
+void registerProbe(ProbeDescriptor probe);
+
+// All registered probes, built-ins included, in section order.
+const std::vector<ProbeDescriptor>& probeRegistry();
+const ProbeDescriptor* findProbe(ProbeSection section);
+
+// Run order for `sections`: critical first, then by cost, except that a
+// probe never comes before one it depends on.
+std::vector<const ProbeDescriptor*> probeRunOrder(ProbeMask sections);
+
+// Sections switched off by "disable = name name ..." in
+// /etc/debxray/probes.conf (names as probeSectionName()). Read once.
+ProbeMask disabledProbes();
+
+// The stock probes; defined alongside them in SystemInfo.cpp.
+std::vector<ProbeDescriptor> builtinProbes();
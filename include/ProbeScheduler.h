@@ -0,0 +1,65 @@
+// ----------------------------------------
+// ProbeScheduler.h
+// ----------------------------------------
+#pragma once
+#include "SystemInfo.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Probe code calls this for every subprocess it starts; the scheduler
+// attributes the count to whichever task is running on this thread.
+void noteProbeSpawn();
+
+// Optional hook returning the calling thread's allocation count; the
+// benchmark installs one so each task's allocations can be attributed.
+using AllocationCounter = uint64_t (*)();
+void setProbeAllocationCounter(AllocationCounter counter);
+
+// Runs probe tasks concurrently on a small worker pool, in the order they
+// were added unless a task is still waiting on one it depends on.
+// Each task fills its own SystemInfo; when it finishes, its `merge`
+// copies the fields it owns into the final snapshot. A task that runs
+// past its deadline is abandoned (its worker is replaced) and its fields
+// keep their defaults, so one hung tool cannot stall the snapshot.
+class ProbeScheduler {
+public:
+    using Work  = std::function<void(SystemInfo&)>;
+    using Merge = std::function<void(SystemInfo& out, const SystemInfo& partial)>;
+
+    struct TaskStats {
+        double wallMs = 0.0;     // start → finish, or → abandon on timeout
+        unsigned spawns = 0;     // subprocesses started (see noteProbeSpawn)
+        uint64_t allocations = 0;  // 0 unless an AllocationCounter is set
+        bool timedOut = false;
+        bool failed = false;
+    };
+
+    // Called on the run() thread after each task settles (merged, failed
+    // or timed out), with the task's index in add() order.
+    using Settled = std::function<void(size_t index, const SystemInfo& out, const TaskStats& stats)>;
+
+    explicit ProbeScheduler(unsigned workers = 0);
+
+    // `after` lists indices of earlier tasks that must settle (finish, fail
+    // or time out) before this one starts.
+    void add(std::string name, std::chrono::milliseconds deadline, Work work, Merge merge,
+             std::vector<size_t> after = {});
+
+    // Blocks until every task has finished or timed out.
+    void run(SystemInfo& out, const Settled& onSettled = nullptr);
+
+private:
+    struct Task {
+        std::string name;
+        std::chrono::milliseconds deadline;
+        Work work;
+        Merge merge;
+        std::vector<size_t> after;
+    };
+
+    unsigned workers;
+    std::vector<Task> tasks;
+};
@@ -0,0 +1,51 @@
+// ----------------------------------------
+// Smbios.h
+// ----------------------------------------
+// Native SMBIOS/DMI decoder. Reads the firmware table exported by the
+// kernel under /sys/firmware/dmi/tables once and decodes the structures
+// debXray needs (types 1, 2, 3 and 17) in a single pass, replacing the
+// separate `dmidecode` invocations.
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct MemoryModule {
+    std::string locator;     // e.g. "DIMM A1", "ChannelA-DIMM0"
+    std::string type;        // e.g. "DDR4"
+    unsigned speedMTs = 0;   // rated speed in MT/s, 0 if unknown
+    unsigned long sizeMB = 0;
+};
+
+struct SmbiosInfo {
+    int versionMajor = 0;
+    int versionMinor = 0;
+
+    // Type 1 — System
+    std::string manufacturer;
+    std::string productName;
+    std::string productVersion;
+    std::string serial;
+    std::string uuid;            // lowercase, "" if unset
+
+    // Type 2 — Baseboard
+    std::string boardVendor;
+    std::string boardName;
+    std::string boardSerial;
+
+    // Type 3 — Chassis
+    uint8_t chassisType = 0;     // SMBIOS chassis code, 0 if absent
+
+    // Type 17 — Memory Device (populated slots only)
+    std::vector<MemoryModule> modules;
+};
+
+// Decodes the table under `dir` (default /sys/firmware/dmi/tables).
+// Returns false if the table is missing or unreadable (it is root-only).
+bool readSmbios(SmbiosInfo& out, const std::string& dir = "/sys/firmware/dmi/tables");
+
+// Portable, Laptop, Notebook, Sub Notebook, Tablet.
+bool isPortableChassis(uint8_t chassisType);
+
+// SMBIOS 7.18.2 memory type name, e.g. 0x1A → "DDR4" ("" for Unknown/Other).
+const char* smbiosMemoryTypeName(uint8_t type);
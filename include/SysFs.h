@@ -0,0 +1,70 @@
+// ----------------------------------------
+// SysFs.h
+// ----------------------------------------
+// Small native reading layer for /proc and /sys. Pseudo-files are read
+// with a single read() into a caller-owned fixed buffer and tokenized as
+// string_views, so a probe costs a couple of syscalls instead of a
+// fork/exec of sh + grep + awk.
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// ── Fixture root
+// Every path read through this layer is resolved under the sysroot, so
+// the probes can run against a recorded /sys + /proc tree (see bench/).
+// Empty — the default — means the live system. Set it before probing;
+// it isn't synchronized with readers.
+void setSysRoot(std::string root);
+const std::string& sysRoot();
+
+// `path` under the sysroot; just `path` when none is set.
+std::string sysPath(const std::string& path);
+
+// With a sysroot set, tool pipelines aren't run: their recorded stdout is
+// read from <sysroot>/commands/<commandFixtureName(cmd)> instead.
+std::string commandFixtureName(std::string_view cmd);
+bool readCommandFixture(std::string_view cmd, std::string& out);
+
+// When a record directory is set, live tool output is saved there under
+// the same name, to capture a fixture from a real machine.
+void setCommandRecordDir(std::string dir);
+void recordCommandFixture(std::string_view cmd, const std::string& output);
+
+// Reads at most size-1 bytes of `path` into `buf` (NUL-terminated).
+// Returns the bytes read, or an empty view if the file can't be opened.
+std::string_view readSysFile(const char* path, char* buf, size_t size);
+
+template <size_t N>
+std::string_view readSysFile(const std::string& path, char (&buf)[N]) {
+    return readSysFile(path.c_str(), buf, N);
+}
+
+// Single-value attribute (e.g. /sys/class/dmi/id/product_name), trimmed.
+std::string readSysString(const std::string& path);
+bool readSysLong(const std::string& path, long& out);
+
+// Whole binary file (e.g. the DMI table), capped at maxBytes.
+bool readSysBytes(const std::string& path, std::vector<unsigned char>& out, size_t maxBytes = 1 << 20);
+
+// Entry names in a directory (no "." / ".."); empty if it doesn't exist.
+std::vector<std::string> listSysDir(const std::string& path);
+bool sysPathExists(const std::string& path);
+
+// ── string_view tokenizing
+std::string_view trimView(std::string_view s);
+bool startsWith(std::string_view s, std::string_view prefix);
+
+// Pops the next '\n'-terminated line off the front of `text`.
+bool nextLine(std::string_view& text, std::string_view& line);
+
+// Value of the first "key<sep> value" line, trimmed ("" if absent).
+// Works for /proc/meminfo, /proc/cpuinfo and uevent-style files.
+std::string_view findField(std::string_view text, std::string_view key, char sep = ':');
+
+// Leading decimal integer of `s` (after whitespace); false if none.
+bool parseLong(std::string_view s, long& out);
+
+// Leading hex integer of `s`, with or without "0x"; false if none.
+bool parseHex(std::string_view s, unsigned long& out);
@@ -2,6 +2,11 @@
 // SystemInfo.h
 // ----------------------------------------
 #pragma once
+#include "Smbios.h"
+#include "Edid.h"
+#include "PowerSupply.h"
+#include <cstdint>
+#include <functional>
 #include <vector>
 #include <string>
 
@@ -10,19 +15,37 @@ struct DriveInfo {
     std::string type;    // HDD, SSD, NVMe
     std::string tran;    // sata, usb, etc.
     std::string model;   // e.g., Samsung SSD
+    unsigned long long sizeBytes = 0;
 };
 
+struct ProbeTiming {
+    std::string section;     // probeSectionName()
+    double wallMs = 0.0;     // monotonic wall time of the probe
+    unsigned spawns = 0;     // subprocesses it started
+    uint64_t allocations = 0;  // only counted under the benchmark
+    bool timedOut = false;
+    bool failed = false;     // threw; fields kept their defaults
+    bool cached = false;     // loaded from the probe cache, not probed
+    bool disabled = false;   // switched off in probes.conf
+    bool unprivileged = false; // needs root but ran without it; may be partial
+};
+
+// One-word outcome for the UI and exporter: "ok", "partial", "timed out",
+// "failed", "cached" or "disabled".
+const char* probeStatus(const ProbeTiming& timing);
+
 struct SystemInfo {
     bool isLaptop = false;
     bool hasNonUsbDrives = false;
 
     std::string model;          // Hardware model
     std::string serial;         // System serial number
+    std::string board;          // Baseboard vendor + name
 
     // CPU-related fields:
     std::string cpuBrand;       // e.g. "Intel(R) Core(TM) i7-"
     std::string cpuModel;       // e.g. "i7-8650U CPU @ 1.90GHz"
-    std::string cpuSpeed;       // e.g. "1.90GHz"  (from lscpu)
+    std::string cpuSpeed;       // e.g. "1.90" (GHz, from the brand string)
 
     std::string physicalCPUs;   // e.g. "1" (number of sockets)
 
@@ -30,16 +53,61 @@ struct SystemInfo {
 
     std::string ram;            // Rounded RAM in GB, e.g. "16 GB"
     std::string memoryType;     // e.g. "DDR4"
+    std::vector<MemoryModule> memoryModules; // populated DIMM slots (SMBIOS type 17)
 
     std::string resolution;     // Screen resolution, e.g. "1920x1080"
     std::string screenSize;     // Diagonal in inches, e.g. "14.0\""
+    std::vector<DisplayOutput> displays;   // connected outputs, internal panel first
 
     std::string battery;        // "Excellent", "Good", "Poor", "N/A", or "None"
+    double batteryHealth = -1;  // combined full/design capacity in %, -1 if unknown
+    std::vector<BatteryInfo> batteries;
 
     std::vector<std::string> pciDevices;   // Filtered PCI devices
     std::vector<std::string> storageTypes; // e.g. {"NVMe","SATA","USB"}
     std::vector<DriveInfo> detectedDrives; // /dev/sdX, type, tran, model
+
+    std::vector<ProbeTiming> timings;      // one per settled section, in completion order
+};
+
+// Independent probe sections; each owns a disjoint set of SystemInfo fields.
+// The set is closed on purpose: a section only exists alongside the fields
+// it fills, which the UI, the JSON report and the probe cache all name, so
+// a new one is an edit here whatever the registry looks like. What the
+// registry keeps open is everything about a section's probe.
+enum class ProbeSection {
+    Chassis,        // isLaptop
+    StorageBuses,   // storageTypes
+    Identity,       // model, serial, board
+    Cpu,            // cpuBrand, cpuModel, cpuSpeed, physicalCPUs
+    Gpu,            // gpu
+    Memory,         // ram, memoryType, memoryModules
+    Display,        // resolution, screenSize, displays
+    Battery,        // battery, batteryHealth, batteries
+    Pci,            // pciDevices
+    Drives,         // detectedDrives, hasNonUsbDrives
+    Count
 };
+const char* probeSectionName(ProbeSection section);
+
+using ProbeMask = uint32_t;
+constexpr ProbeMask probeBit(ProbeSection section) { return 1u << static_cast<unsigned>(section); }
+constexpr ProbeMask kAllProbeSections = probeBit(ProbeSection::Count) - 1;
+static_assert(static_cast<unsigned>(ProbeSection::Count) < 32, "ProbeMask has one bit per section");
+
+// Invoked once per section as it completes (or times out), with the
+// snapshot so far. Runs on the thread that called getSystemInfo().
+using ProbeCallback = std::function<void(ProbeSection section, const SystemInfo& partial)>;
+
+SystemInfo getSystemInfo(const ProbeCallback& onSection = nullptr);
+
+// What each field reads before (or if never) its probe lands.
+SystemInfo defaultSystemInfo();
+
+// Re-runs only `sections`, overwriting their fields (and timings) in `info`.
+void refreshSystemInfo(SystemInfo& info, ProbeMask sections, const ProbeCallback& onSection = nullptr);
 
-SystemInfo getSystemInfo();
+// Sections with a fallback that needs a tool from one of `packages`, i.e.
+// the ones worth re-running after those packages are installed.
+ProbeMask probeSectionsUsingPackages(const std::vector<std::string>& packages);
 bool isAppleOrSurface(const std::string& model);
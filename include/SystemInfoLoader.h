@@ -0,0 +1,40 @@
+// ----------------------------------------
+// SystemInfoLoader.h
+// ----------------------------------------
+#pragma once
+#include "SystemInfo.h"
+#include <cstdint>
+#include <memory>
+
+// Runs getSystemInfo() on a background thread and publishes each section
+// as it completes, so the UI can draw its first frame immediately and
+// fill fields in as probes land. The UI thread never blocks on probing.
+class SystemInfoLoader {
+public:
+    SystemInfoLoader();
+
+    void start();
+
+    // Re-probes just `sections` on top of the latest snapshot (e.g. after
+    // installing the tools their fallbacks need). They read as not ready
+    // until the new results land.
+    void refresh(ProbeMask sections);
+
+    // Copies the latest snapshot into `out` if a section landed since the
+    // previous call. One atomic load when nothing changed.
+    bool poll(SystemInfo& out);
+
+    // State as of the last poll(), so it always matches `out`. Sections
+    // loaded from the probe cache are ready (shown) at once, but the
+    // snapshot is only complete once they have been re-probed live, so a
+    // stale cached answer is never uploaded.
+    bool isReady(ProbeSection section) const;
+    bool isComplete() const;
+
+private:
+    struct State;
+    std::shared_ptr<State> state;   // shared with the probe thread
+    uint64_t seenVersion = 0;
+    ProbeMask readyMask = 0;
+    ProbeMask unverified = 0;
+};
@@ -0,0 +1,37 @@
+// ----------------------------------------
+// Trace.h
+// ----------------------------------------
+// Minimal startup tracer. Scopes record begin/end events with the thread
+// id and a steady-clock nanosecond timestamp; writeTrace() emits them in
+// Chrome trace-event JSON (load in chrome://tracing or ui.perfetto.dev).
+// Until traceEnable() is called, and again once writeTrace() has ended
+// the trace, every hook is a single relaxed load.
+#pragma once
+#include <string>
+
+void traceEnable();
+bool traceEnabled();
+
+// `name` and `category` must outlive the trace (string literals, or
+// probeSectionName()).
+void traceBegin(const char* name, const char* category = "startup");
+void traceEnd(const char* name, const char* category = "startup");
+void traceInstant(const char* name, const char* category = "startup");
+
+class TraceScope {
+public:
+    explicit TraceScope(const char* name, const char* category = "startup")
+    : name(name), category(category) { traceBegin(name, category); }
+    ~TraceScope() { traceEnd(name, category); }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name;
+    const char* category;
+};
+
+// Writes the events recorded so far and stops recording; a trace is
+// written once.
+bool writeTrace(const std::string& path);
@@ -3,14 +3,16 @@
 
 class WebcamFeed {
 public:
+    // Starts looking for a camera in the background; never blocks.
     explicit WebcamFeed(SDL_Renderer* r);
     ~WebcamFeed();
 
     void update();
     SDL_Texture* getTexture() const;
+    bool isSearching() const;
     bool isFailed() const;
 
 private:
     class Impl;
     Impl* impl;
-};
\ No newline at end of file
+};
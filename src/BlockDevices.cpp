@@ -0,0 +1,112 @@
+// ----------------------------------------
+// BlockDevices.cpp
+// ----------------------------------------
+#include "BlockDevices.h"
+#include "SysFs.h"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+namespace {
+
+bool isVirtualDisk(const std::string& name) {
+    return startsWith(name, "loop") || startsWith(name, "ram") ||
+           startsWith(name, "zram") || startsWith(name, "sr");
+}
+
+bool pathHas(const std::string& path, const char* component) {
+    return path.find(component) != std::string::npos;
+}
+
+// SCSI address of a disk whose device path ends in
+// .../hostH/targetH:C:T/H:C:T:L/block/sdX, as "H:C:T:L"; "" otherwise.
+std::string scsiAddress(const std::string& devicePath, std::string& host) {
+    size_t block = devicePath.rfind("/block/");
+    if (block == std::string::npos) return "";
+    size_t slash = devicePath.rfind('/', block - 1);
+    if (slash == std::string::npos) return "";
+    std::string hctl = devicePath.substr(slash + 1, block - slash - 1);
+    if (std::count(hctl.begin(), hctl.end(), ':') != 3) return "";
+    for (char c : hctl) {
+        if (c != ':' && (c < '0' || c > '9')) return "";
+    }
+    host = hctl.substr(0, hctl.find(':'));
+    return hctl;
+}
+
+// lsblk's scsi_host_is(): the host is registered with this transport.
+bool hostIs(const std::string& host, const char* type) {
+    return sysPathExists(std::string("/sys/class/") + type + "_host/host" + host);
+}
+
+} // namespace
+
+std::string blockTransport(const std::string& name, const std::string& devicePath) {
+    std::string host;
+    std::string hctl = scsiAddress(devicePath, host);
+    if (!hctl.empty()) {
+        // Same precedence as lsblk's TRAN column.
+        std::string target = "target" + hctl.substr(0, hctl.rfind(':'));
+        if (hostIs(host, "spi") || sysPathExists("/sys/class/spi_transport/" + target)) return "spi";
+        if (hostIs(host, "fc") || sysPathExists("/sys/class/fc_transport/" + target)) {
+            std::string symbolic = readSysString("/sys/class/fc_host/host" + host + "/symbolic_name");
+            return pathHas(symbolic, " over ") ? "fcoe" : "fc";
+        }
+        if (hostIs(host, "sas") || pathHas(devicePath, "/end_device-") ||
+            sysPathExists("/sys/bus/scsi/devices/" + hctl + "/sas_device"))        return "sas";
+        if (sysPathExists("/sys/bus/scsi/devices/" + hctl + "/ieee1394_id"))     return "sbp";
+        if (hostIs(host, "iscsi") || pathHas(devicePath, "/session"))           return "iscsi";
+        if (pathHas(devicePath, "/usb"))                                         return "usb";
+
+        std::string proc = readSysString("/sys/class/scsi_host/host" + host + "/proc_name");
+        if (startsWith(proc, "ahci") || startsWith(proc, "sata")) return "sata";
+        if (pathHas(proc, "ata"))                                 return "ata";
+        // Under a SCSI host we can't classify (virtio_scsi, a RAID HBA,
+        // an unknown driver): still a real disk, so never "" and never
+        // mistaken for USB by the drive gate.
+        return "scsi";
+    }
+
+    if (pathHas(devicePath, "/usb"))                                  return "usb";
+    if (startsWith(name, "nvme") || pathHas(devicePath, "/nvme/"))    return "nvme";
+    if (startsWith(name, "vd"))                                       return "virtio";
+    if (startsWith(name, "mmcblk") || pathHas(devicePath, "/mmc_host/")) return "mmc";
+    return "";
+}
+
+std::vector<BlockDevice> enumerateBlockDevices(const std::string& root) {
+    std::vector<BlockDevice> devices;
+
+    for (const auto& name : listSysDir(root)) {
+        if (isVirtualDisk(name)) continue;
+        std::string base = root + "/" + name;
+
+        // /sys/block entries are symlinks into the device tree; the target
+        // path encodes the bus the disk hangs off.
+        char resolved[PATH_MAX];
+        std::string devicePath = ::realpath(sysPath(base).c_str(), resolved) ? resolved : base;
+        if (!sysRoot().empty() && startsWith(devicePath, sysRoot()))
+            devicePath.erase(0, sysRoot().size());
+
+        BlockDevice d;
+        d.name = name;
+        d.tran = blockTransport(name, devicePath);
+
+        long flag = 0;
+        if (readSysLong(base + "/queue/rotational", flag)) d.rotational = flag != 0;
+        if (readSysLong(base + "/removable", flag))        d.removable  = flag != 0;
+
+        long sectors = 0;
+        if (readSysLong(base + "/size", sectors) && sectors > 0)
+            d.sizeBytes = static_cast<unsigned long long>(sectors) * 512ULL;
+
+        d.model = readSysString(base + "/device/model");          // SCSI/ATA, NVMe ctrl
+        if (d.model.empty()) d.model = readSysString(base + "/device/name");   // MMC
+
+        devices.push_back(std::move(d));
+    }
+
+    std::sort(devices.begin(), devices.end(),
+              [](const BlockDevice& a, const BlockDevice& b) { return a.name < b.name; });
+    return devices;
+}
@@ -0,0 +1,113 @@
+// ----------------------------------------
+// Capabilities.cpp
+// ----------------------------------------
+#include "Capabilities.h"
+#include "SysFs.h"
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <string_view>
+#include <unistd.h>
+
+namespace {
+
+constexpr uint32_t bit(Capability cap) { return 1u << static_cast<unsigned>(cap); }
+
+struct ToolCheck {
+    Capability cap;
+    const char* binary;
+};
+
+constexpr ToolCheck kTools[] = {
+    { Capability::Dmidecode,   "dmidecode"   },
+    { Capability::Screenfetch, "screenfetch" },
+    { Capability::Xdpyinfo,    "xdpyinfo"    },
+    { Capability::Xrandr,      "xrandr"      },
+};
+
+bool anyConnectorHasEdid() {
+    for (const auto& name : listSysDir("/sys/class/drm")) {
+        if (name.find('-') != std::string::npos && sysPathExists("/sys/class/drm/" + name + "/edid"))
+            return true;
+    }
+    return false;
+}
+
+uint32_t scan() {
+    uint32_t mask = 0;
+    if (access(sysPath("/sys/firmware/dmi/tables/DMI").c_str(), R_OK) == 0)  mask |= bit(Capability::SmbiosTables);
+    if (sysPathExists("/sys/class/dmi/id"))                   mask |= bit(Capability::DmiSysfs);
+    if (sysPathExists("/sys/bus/pci/devices"))                mask |= bit(Capability::PciSysfs);
+    if (anyConnectorHasEdid())                                mask |= bit(Capability::DrmEdid);
+    if (sysPathExists("/sys/class/power_supply"))             mask |= bit(Capability::PowerSupply);
+    if (sysPathExists("/sys/block"))                          mask |= bit(Capability::BlockSysfs);
+    for (const auto& tool : kTools) {
+        if (!findOnPath(tool.binary).empty()) mask |= bit(tool.cap);
+    }
+    return mask;
+}
+
+std::atomic<uint32_t> gMask{0};
+std::once_flag gScanned;
+
+uint32_t currentMask() {
+    std::call_once(gScanned, [] { gMask.store(scan(), std::memory_order_release); });
+    return gMask.load(std::memory_order_acquire);
+}
+
+} // namespace
+
+const char* capabilityName(Capability cap) {
+    switch (cap) {
+    case Capability::SmbiosTables: return "smbios";
+    case Capability::DmiSysfs:     return "dmi";
+    case Capability::PciSysfs:     return "pci";
+    case Capability::DrmEdid:      return "edid";
+    case Capability::PowerSupply:  return "power_supply";
+    case Capability::BlockSysfs:   return "block";
+    case Capability::Dmidecode:    return "dmidecode";
+    case Capability::Screenfetch:  return "screenfetch";
+    case Capability::Xdpyinfo:     return "xdpyinfo";
+    case Capability::Xrandr:       return "xrandr";
+    default:                       return "unknown";
+    }
+}
+
+bool hasCapability(Capability cap) {
+    return currentMask() & bit(cap);
+}
+
+void rescanCapabilities() {
+    currentMask();
+    gMask.store(scan(), std::memory_order_release);
+}
+
+std::string describeCapabilities() {
+    std::string native, tools;
+    for (unsigned i = 0; i < static_cast<unsigned>(Capability::Count); ++i) {
+        Capability cap = static_cast<Capability>(i);
+        if (!hasCapability(cap)) continue;
+        std::string& out = cap >= Capability::Dmidecode ? tools : native;
+        if (!out.empty()) out += ' ';
+        out += capabilityName(cap);
+    }
+    return (native.empty() ? "none" : native) + " | tools: " + (tools.empty() ? "none" : tools);
+}
+
+std::string findOnPath(const char* tool) {
+    const char* path = std::getenv("PATH");
+    std::string_view dirs = path && *path ? path : "/usr/local/sbin:/usr/local/bin:/usr/sbin:/usr/bin:/sbin:/bin";
+    // dmidecode lives in sbin, which isn't on a normal user's PATH.
+    std::string all = std::string(dirs) + ":/usr/sbin:/sbin";
+
+    std::string_view rest = all;
+    while (!rest.empty()) {
+        size_t colon = rest.find(':');
+        std::string_view dir = rest.substr(0, colon);
+        rest = colon == std::string_view::npos ? std::string_view() : rest.substr(colon + 1);
+        if (dir.empty()) continue;
+        std::string candidate = std::string(dir) + "/" + tool;
+        if (access(sysPath(candidate).c_str(), X_OK) == 0) return candidate;
+    }
+    return "";
+}
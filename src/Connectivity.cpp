@@ -0,0 +1,228 @@
+// ----------------------------------------
+// Connectivity.cpp
+// ----------------------------------------
+#include "Connectivity.h"
+#include "Log.h"
+#include "Trace.h"
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Address {
+    int family = 0;
+    int socktype = 0;
+    int protocol = 0;
+    sockaddr_storage addr{};
+    socklen_t len = 0;
+};
+
+using Addresses = std::vector<Address>;
+
+struct Lookup {
+    std::mutex m;
+    std::condition_variable cv;
+    bool done = false;
+    bool ok = false;
+    Addresses addrs;
+};
+
+// Last successful resolution per host:port, used when the resolver is
+// slower than the check's deadline (e.g. a dead DNS server on a link that
+// otherwise works), and the lookup currently in flight for it, if any.
+// Never destroyed: a stalled helper may still finish after exit() began.
+struct Resolver {
+    std::mutex m;
+    std::map<std::string, Addresses> resolved;
+    std::map<std::string, std::shared_ptr<Lookup>> pending;
+};
+
+Resolver& resolver() {
+    static Resolver* r = new Resolver;
+    return *r;
+}
+
+// getaddrinfo() has no timeout of its own, so it runs on a detached
+// helper that owns the shared result; a stalled lookup finishes (or not)
+// on its own time while the caller gives up at `deadline`. At most one
+// helper runs per host:port: while the resolver stalls, later checks wait
+// on the same lookup instead of piling up threads behind it.
+bool resolveBefore(const std::string& host, const std::string& port,
+                   Clock::time_point deadline, Addresses& out) {
+    std::string key = host + ":" + port;
+    std::shared_ptr<Lookup> lookup;
+    {
+        Resolver& r = resolver();
+        std::lock_guard<std::mutex> cacheLock(r.m);
+        auto& slot = r.pending[key];
+        if (!slot) {
+            slot = std::make_shared<Lookup>();
+            std::thread([lookup = slot, key, host, port] {
+                addrinfo hints{};
+                hints.ai_family   = AF_UNSPEC;
+                hints.ai_socktype = SOCK_STREAM;
+                addrinfo* res = nullptr;
+                Addresses addrs;
+                bool ok = getaddrinfo(host.c_str(), port.c_str(), &hints, &res) == 0;
+                for (addrinfo* ai = ok ? res : nullptr; ai; ai = ai->ai_next) {
+                    if (ai->ai_addrlen > sizeof(sockaddr_storage)) continue;
+                    Address a;
+                    a.family   = ai->ai_family;
+                    a.socktype = ai->ai_socktype;
+                    a.protocol = ai->ai_protocol;
+                    std::memcpy(&a.addr, ai->ai_addr, ai->ai_addrlen);
+                    a.len = ai->ai_addrlen;
+                    addrs.push_back(a);
+                }
+                if (res) freeaddrinfo(res);
+                ok = ok && !addrs.empty();
+
+                // Publish to the cache here rather than in the caller, so
+                // a lookup that outlived its check still refreshes it.
+                {
+                    Resolver& r = resolver();
+                    std::lock_guard<std::mutex> cacheLock(r.m);
+                    if (ok) r.resolved[key] = addrs;
+                    r.pending.erase(key);
+                }
+                std::lock_guard<std::mutex> lock(lookup->m);
+                lookup->ok = ok;
+                lookup->addrs = std::move(addrs);
+                lookup->done = true;
+                lookup->cv.notify_all();
+            }).detach();
+        }
+        lookup = slot;
+    }
+
+    std::unique_lock<std::mutex> lock(lookup->m);
+    if (lookup->cv.wait_until(lock, deadline, [&] { return lookup->done; })) {
+        if (!lookup->ok) return false;
+        out = lookup->addrs;
+        return true;
+    }
+    lock.unlock();
+
+    Resolver& r = resolver();
+    std::lock_guard<std::mutex> cacheLock(r.m);
+    auto it = r.resolved.find(key);
+    if (it == r.resolved.end()) return false;
+    out = it->second;
+    return true;
+}
+
+// Non-blocking connect to one address; true once the handshake completes
+// before `deadline`.
+bool connectBefore(const Address& a, Clock::time_point deadline) {
+    int fd = socket(a.family, a.socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, a.protocol);
+    if (fd < 0) return false;
+
+    bool ok = false;
+    if (connect(fd, reinterpret_cast<const sockaddr*>(&a.addr), a.len) == 0) {
+        ok = true;
+    } else if (errno == EINPROGRESS) {
+        pollfd pfd{ fd, POLLOUT, 0 };
+        for (;;) {
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now());
+            if (left.count() <= 0) break;
+            int n = poll(&pfd, 1, static_cast<int>(left.count()));
+            if (n < 0 && errno == EINTR) continue;
+            if (n > 0) {
+                int err = 0;
+                socklen_t len = sizeof(err);
+                ok = getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &len) == 0 && err == 0;
+            }
+            break;
+        }
+    }
+    close(fd);
+    return ok;
+}
+
+} // namespace
+
+const char* linkStatusName(LinkStatus status) {
+    switch (status) {
+    case LinkStatus::Online:  return "Online";
+    case LinkStatus::Offline: return "Offline";
+    default:                  return "Checking";
+    }
+}
+
+bool canReach(const std::string& host, const std::string& port, std::chrono::milliseconds timeout) {
+    auto deadline = Clock::now() + timeout;
+
+    Addresses addrs;
+    if (!resolveBefore(host, port, deadline, addrs)) return false;
+
+    bool ok = false;
+    for (size_t i = 0; i < addrs.size() && !ok && Clock::now() < deadline; ++i)
+        ok = connectBefore(addrs[i], deadline);
+    return ok;
+}
+
+struct ConnectivityMonitor::State {
+    std::atomic<LinkStatus> status{LinkStatus::Unknown};
+    std::mutex m;
+    std::condition_variable cv;
+    bool wake = false;
+    bool stop = false;
+};
+
+ConnectivityMonitor::ConnectivityMonitor(std::string host, std::string port,
+                                         std::chrono::milliseconds timeout,
+                                         std::chrono::milliseconds interval)
+: state(std::make_shared<State>()), host(std::move(host)), port(std::move(port)),
+  timeout(timeout), interval(interval) {}
+
+ConnectivityMonitor::~ConnectivityMonitor() {
+    std::lock_guard<std::mutex> lock(state->m);
+    state->stop = true;
+    state->cv.notify_all();
+}
+
+void ConnectivityMonitor::start() {
+    // Detached: a resolver stall must never hold up shutdown. The thread
+    // owns a reference to the state and exits once `stop` is set.
+    std::thread([st = state, host = host, port = port, timeout = timeout, interval = interval] {
+        std::unique_lock<std::mutex> lock(st->m);
+        while (!st->stop) {
+            lock.unlock();
+            traceBegin("connectivity check", "net");
+            LinkStatus now = canReach(host, port, timeout) ? LinkStatus::Online : LinkStatus::Offline;
+            traceEnd("connectivity check", "net");
+            LinkStatus was = st->status.exchange(now, std::memory_order_acq_rel);
+            if (now != was) {
+                bool online = now == LinkStatus::Online;
+                logRecord(online ? LogLevel::Success : LogLevel::Warning, LogSource::Network,
+                          online ? "Network online." : "Network offline.", {{"host", host}});
+            }
+            lock.lock();
+            st->cv.wait_for(lock, interval, [&] { return st->stop || st->wake; });
+            st->wake = false;
+        }
+    }).detach();
+}
+
+LinkStatus ConnectivityMonitor::status() const {
+    return state->status.load(std::memory_order_acquire);
+}
+
+void ConnectivityMonitor::recheck() {
+    std::lock_guard<std::mutex> lock(state->m);
+    state->wake = true;
+    state->cv.notify_all();
+}
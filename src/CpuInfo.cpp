@@ -0,0 +1,71 @@
+// ----------------------------------------
+// CpuInfo.cpp
+// ----------------------------------------
+#include "CpuInfo.h"
+#include "SysFs.h"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+namespace {
+
+constexpr bool parsesTo(std::string_view s, std::string_view brand, std::string_view model, std::string_view speed) {
+    CpuNameParts p = parseCpuNameParts(s);
+    return p.brand.view() == brand && p.model.view() == model && p.speed == speed;
+}
+
+// Known parses, pinned so a scanner or noise-list change can't silently
+// alter what we report for the common Intel and AMD strings. "" is Unknown.
+static_assert(parsesTo("Intel(R) Core(TM) i7-8650U CPU @ 1.90GHz", "Intel Core i7", "8650U", "1.90"));
+static_assert(parsesTo("Intel(R) Core(TM) i5-10210U CPU @ 1.60GHz", "Intel Core i5", "10210U", "1.60"));
+static_assert(parsesTo("11th Gen Intel(R) Core(TM) i7-1165G7 @ 2.80GHz", "Intel Core i7", "1165G", "2.80"));
+static_assert(parsesTo("12th Gen Intel(R) Core(TM) i5-1235U", "Intel Core i5", "1235U", ""));
+static_assert(parsesTo("Intel(R) Xeon(R) CPU E5-2680 v4 @ 2.40GHz", "Intel Xeon E5", "2680 v4", "2.40"));
+static_assert(parsesTo("Intel(R) Xeon(R) Gold 6248R CPU @ 3.00GHz", "Intel Xeon Gold", "6248R", "3.00"));
+static_assert(parsesTo("Intel(R) Xeon(R) Processor", "", "Intel Xeon", ""));
+static_assert(parsesTo("Intel(R) Pentium(R) CPU G4560 @ 3.50GHz", "Intel Pentium", "G4560", "3.50"));
+static_assert(parsesTo("Intel(R) Pentium(R) Silver N5000 CPU @ 1.10GHz", "Intel Pentium Silver", "N5000", "1.10"));
+static_assert(parsesTo("Intel(R) Celeron(R) CPU N3060 @ 1.60GHz", "Intel Celeron", "N3060", "1.60"));
+static_assert(parsesTo("  Intel(R) Celeron(R) CPU  J1900  @ 1.99GHz", "Intel Celeron", "J1900", "1.99"));
+static_assert(parsesTo("AMD Ryzen 7 5800X 8-Core Processor", "AMD Ryzen 7", "5800X", ""));
+static_assert(parsesTo("AMD Ryzen 5 PRO 4650U with Radeon Graphics", "AMD Ryzen 5 PRO", "4650U", ""));
+static_assert(parsesTo("AMD Ryzen 7 3700U with Radeon Vega Mobile Gfx", "AMD Ryzen 7", "3700U", ""));
+static_assert(parsesTo("AMD Ryzen Threadripper PRO 3995WX 64-Cores", "AMD Ryzen Threadripper PRO", "3995WX", ""));
+static_assert(parsesTo("AMD EPYC 7763 64-Core Processor", "AMD EPYC", "7763", ""));
+static_assert(parsesTo("AMD EPYC Processor (with IBPB)", "", "AMD EPYC", ""));
+static_assert(parsesTo("AMD Eng Sample 12-Core Processor", "", "AMD Eng Sample", ""));
+static_assert(parsesTo("", "", "", ""));
+
+} // namespace
+
+std::string readCpuBrandString() {
+#if defined(__x86_64__) || defined(__i386__)
+    // A fixture root describes some other machine; CPUID would describe this one.
+    unsigned int regs[12] = {};
+    if (sysRoot().empty() && __get_cpuid_max(0x80000000, nullptr) >= 0x80000004) {
+        for (unsigned int leaf = 0; leaf < 3; ++leaf) {
+            unsigned int* r = regs + leaf * 4;
+            __get_cpuid(0x80000002 + leaf, &r[0], &r[1], &r[2], &r[3]);
+        }
+        char brand[sizeof(regs) + 1] = {};
+        std::memcpy(brand, regs, sizeof(regs));
+        // Older Intel parts right-justify the string with leading spaces.
+        std::string s(trimView(brand));
+        if (!s.empty()) return s;
+    }
+#endif
+    // The first processor block is all we need; no need to read every core.
+    char cpuinfo[4096];
+    return std::string(findField(readSysFile("/proc/cpuinfo", cpuinfo), "model name"));
+}
+
+CpuName parseCpuName(std::string_view brandString) {
+    CpuNameParts parts = parseCpuNameParts(brandString);
+    CpuName out;
+    if (parts.brand.len) out.brand = std::string(parts.brand.view());
+    if (parts.model.len) out.model = std::string(parts.model.view());
+    if (!parts.speed.empty()) out.speed = std::string(parts.speed);
+    return out;
+}
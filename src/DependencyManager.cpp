@@ -1,50 +1,185 @@
 #include "DependencyManager.h"
 #include "Log.h"
+#include "DpkgStatus.h"
+#include "Capabilities.h"
+#include "Trace.h"
 #include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdio>
 #include <cstdlib>
+#include <mutex>
+#include <thread>
 #include <vector>
 
-bool isOnline() {
-    return system("ping -c1 -W1 8.8.8.8 > /dev/null 2>&1") == 0;
+namespace {
+
+// External tools the probes can fall back on, the native source that makes
+// each one unnecessary, and the package that ships it. curl, upower,
+// pciutils and v4l-utils used to be listed too; nothing shells out to them
+// any more.
+struct ToolDependency {
+    Capability tool;
+    Capability native;
+    const char* package;
+};
+
+constexpr ToolDependency kDependencies[] = {
+    { Capability::Dmidecode,   Capability::SmbiosTables, "dmidecode"         },
+    { Capability::Screenfetch, Capability::PciSysfs,     "screenfetch"       },
+    { Capability::Xdpyinfo,    Capability::DrmEdid,      "x11-utils"         },
+    { Capability::Xrandr,      Capability::DrmEdid,      "x11-xserver-utils" },
+};
+
+// Shares of the progress bar: update is quick and reports nothing, then
+// apt's download and dpkg phases split the rest.
+constexpr float kUpdateShare   = 0.1f;
+constexpr float kDownloadShare = 0.4f;
+
+std::string privilegePrefix() {
+    if (isRoot()) return "";
+    if (access("/usr/bin/pkexec", X_OK) == 0) return "pkexec ";
+    return "sudo ";
 }
 
+} // namespace
+
 bool isRoot() {
     return geteuid() == 0;
 }
 
-void installDependencies() {
-    const std::vector<std::string> packages = {
-        "curl",
-        "screenfetch",
-        "dmidecode",
-        "upower",
-        "x11-utils",
-        "x11-xserver-utils",
-        "v4l-utils",
-        "pciutils"
-    };
+std::vector<std::string> missingDependencies() {
+    // A tool is only a gap when it's absent and its native source is too,
+    // and apt can't fix what dpkg already has: a package can be installed
+    // with its tool off our PATH (dmidecode lives in /usr/sbin).
     std::vector<std::string> missing;
-    for (const auto& pkg : packages) {
-        std::string checkCmd = "dpkg -s " + pkg + " > /dev/null 2>&1";
-        if (system(checkCmd.c_str()) != 0) missing.push_back(pkg);
+    for (const auto& dep : kDependencies) {
+        if (hasCapability(dep.tool) || hasCapability(dep.native)) continue;
+        if (isPackageInstalled(dep.package)) continue;
+        if (std::find(missing.begin(), missing.end(), dep.package) == missing.end())
+            missing.push_back(dep.package);
     }
+    return missing;
+}
 
-    if (missing.empty()) {
-        logMessage("[+] All dependencies already installed.");
-        return;
+struct DependencyInstaller::State {
+    std::atomic<Phase> phase{Phase::Idle};
+    std::atomic<float> progress{0.0f};
+    std::atomic<bool> finished{false};
+    mutable std::mutex m;
+    std::string action;
+    std::vector<std::string> installed;
+
+    void setAction(std::string text) {
+        std::lock_guard<std::mutex> lock(m);
+        action = std::move(text);
     }
 
+    // Runs one apt-get command, logging its output. Status-Fd lines look
+    // like "pmstatus:<pkg>:<percent>:<message>" and are turned into
+    // progress instead of being logged verbatim.
+    bool runApt(const std::string& command) {
+        FILE* pipe = popen((command + " 2>&1").c_str(), "r");
+        if (!pipe) return false;
+
+        std::array<char, 512> buf;
+        while (fgets(buf.data(), buf.size(), pipe)) {
+            std::string line(buf.data());
+            line.erase(line.find_last_not_of("\r\n") + 1);
+            if (line.empty()) continue;
+
+            bool dl = line.rfind("dlstatus:", 0) == 0;
+            bool pm = line.rfind("pmstatus:", 0) == 0;
+            if (!dl && !pm) {
+                logRecord(LogLevel::Info, LogSource::Packages, "apt: " + line);
+                continue;
+            }
+            size_t a = line.find(':', 9);
+            size_t b = a == std::string::npos ? a : line.find(':', a + 1);
+            if (b == std::string::npos) continue;
+            float pct = std::strtof(line.c_str() + a + 1, nullptr) / 100.0f;
+            progress = dl ? kUpdateShare + kDownloadShare * pct
+                          : kUpdateShare + kDownloadShare + (1.0f - kUpdateShare - kDownloadShare) * pct;
+            setAction(line.substr(b + 1));
+        }
+        return pclose(pipe) == 0;
+    }
+};
+
+DependencyInstaller::DependencyInstaller() : state(std::make_shared<State>()) {}
+
+void DependencyInstaller::start(std::vector<std::string> packages) {
+    if (packages.empty() || isBusy()) return;
+
     std::string pkgList;
-    for (const auto& pkg : missing) pkgList += pkg + " ";
-    std::string command;
-
-    if (isRoot())
-        command = "apt-get update && apt-get install -y " + pkgList;
-    else if (system("which pkexec > /dev/null 2>&1") == 0)
-        command = "pkexec apt-get update && pkexec apt-get install -y " + pkgList;
-    else
-        command = "sudo apt-get update && sudo apt-get install -y " + pkgList;
-
-    int status = system(command.c_str());
-    logMessage(status == 0 ? "[+] Dependencies installed." : "[-] Failed to install some dependencies.");
-}
\ No newline at end of file
+    for (const auto& pkg : packages) pkgList += pkg + " ";
+    logRecord(LogLevel::Info, LogSource::Packages, "Installing dependencies: " + pkgList);
+
+    state->phase    = Phase::Updating;
+    state->progress = 0.0f;
+    state->setAction("Updating package lists...");
+
+    // Detached: the state is shared and the UI only polls it. apt does not
+    // outlive the process (its output pipe breaks), so main() holds off
+    // exiting while isBusy().
+    std::thread([st = state, packages = std::move(packages), pkgList] {
+        std::string sudo = privilegePrefix();
+        traceBegin("apt-get update", "deps");
+        bool ok = st->runApt(sudo + "apt-get -q update");
+        traceEnd("apt-get update", "deps");
+
+        if (ok) {
+            st->phase    = Phase::Installing;
+            st->progress = kUpdateShare;
+            st->setAction("Installing " + pkgList);
+            TraceScope trace("apt-get install", "deps");
+            ok = st->runApt(sudo + "env DEBIAN_FRONTEND=noninteractive apt-get -q -y "
+                            "-o APT::Status-Fd=1 install " + pkgList);
+        }
+
+        rescanCapabilities();
+        DpkgStatus& dpkg = DpkgStatus::instance();
+        dpkg.reload();
+        std::vector<std::string> installed;
+        for (const auto& pkg : packages) {
+            if (dpkg.isInstalled(pkg)) installed.push_back(pkg);
+        }
+
+        if (ok) logRecord(LogLevel::Success, LogSource::Packages, "Dependencies installed.");
+        else    logRecord(LogLevel::Error, LogSource::Packages, "Failed to install some dependencies.");
+        {
+            std::lock_guard<std::mutex> lock(st->m);
+            st->installed = std::move(installed);
+            st->action    = ok ? "Done" : "Failed";
+        }
+        st->progress = 1.0f;
+        st->phase    = ok ? Phase::Done : Phase::Failed;
+        st->finished = true;
+    }).detach();
+}
+
+DependencyInstaller::Phase DependencyInstaller::phase() const {
+    return state->phase;
+}
+
+bool DependencyInstaller::isBusy() const {
+    Phase p = state->phase;
+    return p == Phase::Updating || p == Phase::Installing;
+}
+
+float DependencyInstaller::progress() const {
+    return state->progress;
+}
+
+std::string DependencyInstaller::action() const {
+    std::lock_guard<std::mutex> lock(state->m);
+    return state->action;
+}
+
+bool DependencyInstaller::takeFinished(std::vector<std::string>& installed) {
+    if (!state->finished.exchange(false)) return false;
+    std::lock_guard<std::mutex> lock(state->m);
+    installed = std::move(state->installed);
+    return true;
+}
@@ -0,0 +1,116 @@
+// ----------------------------------------
+// DpkgStatus.cpp
+// ----------------------------------------
+#include "DpkgStatus.h"
+#include "Log.h"
+#include "SysFs.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// "install ok installed" / "hold ok installed" → installed; anything
+// else (config-files, half-installed, deinstall ...) is not.
+bool statusInstalled(std::string_view status) {
+    status = trimView(status);
+    size_t sp = status.rfind(' ');
+    return status.substr(sp == std::string_view::npos ? 0 : sp + 1) == "installed";
+}
+
+} // namespace
+
+DpkgStatus& DpkgStatus::instance() {
+    static DpkgStatus status;
+    return status;
+}
+
+DpkgStatus::DpkgStatus(std::string path) : path(std::move(path)) {
+    std::lock_guard<std::mutex> lock(m);
+    scan();
+}
+
+bool DpkgStatus::isInstalled(std::string_view package) {
+    std::lock_guard<std::mutex> lock(m);
+    return installed.count(std::string(package)) != 0;
+}
+
+bool DpkgStatus::hasDatabase() {
+    std::lock_guard<std::mutex> lock(m);
+    return statSize >= 0;
+}
+
+void DpkgStatus::reload() {
+    std::lock_guard<std::mutex> lock(m);
+    scan();
+}
+
+void DpkgStatus::scan() {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat st;
+    if (fd < 0 || ::fstat(fd, &st) != 0) {
+        if (fd >= 0) ::close(fd);
+        installed.clear();
+        statSize = -1;
+        return;
+    }
+    if (st.st_ino == statIno && st.st_size == statSize && st.st_mtime == statMtime) {
+        ::close(fd);
+        return;
+    }
+
+    installed.clear();
+    statIno   = st.st_ino;
+    statSize  = st.st_size;
+    statMtime = st.st_mtime;
+    if (st.st_size == 0) {
+        ::close(fd);
+        return;
+    }
+
+    void* p = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        logRecord(LogLevel::Warning, LogSource::Packages, "Could not map " + path + ".");
+        statSize = -1;
+        return;
+    }
+    ::madvise(p, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+
+    // Stanzas are separated by blank lines; only the Package and Status
+    // lines matter. Descriptions and conffiles (continuation lines start
+    // with a space) are skipped on their first byte.
+    std::string_view text(static_cast<const char*>(p), static_cast<size_t>(st.st_size));
+    std::string_view line, package;
+    bool isInstalledStanza = false;
+    auto endStanza = [&] {
+        if (!package.empty() && isInstalledStanza) installed.emplace(package);
+        package = {};
+        isInstalledStanza = false;
+    };
+
+    while (nextLine(text, line)) {
+        if (line.empty()) {
+            endStanza();
+            continue;
+        }
+        switch (line[0]) {
+        case 'P':
+            if (startsWith(line, "Package:")) package = trimView(line.substr(8));
+            break;
+        case 'S':
+            if (startsWith(line, "Status:")) isInstalledStanza = statusInstalled(line.substr(7));
+            break;
+        default:
+            break;
+        }
+    }
+    endStanza();
+
+    ::munmap(p, static_cast<size_t>(st.st_size));
+}
+
+bool isPackageInstalled(std::string_view package) {
+    return DpkgStatus::instance().isInstalled(package);
+}
@@ -0,0 +1,132 @@
+// ----------------------------------------
+// Edid.cpp
+// ----------------------------------------
+#include "Edid.h"
+#include "SysFs.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr unsigned char kEdidHeader[8] = { 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00 };
+
+// Text payload of a display descriptor: up to 13 bytes, 0x0A-terminated,
+// space padded.
+std::string descriptorText(const unsigned char* d) {
+    std::string s;
+    for (int i = 5; i < 18 && d[i] != 0x0A && d[i] != 0x00; ++i) {
+        if (d[i] >= 0x20 && d[i] < 0x7F) s.push_back(static_cast<char>(d[i]));
+    }
+    s.erase(s.find_last_not_of(' ') + 1);
+    return s;
+}
+
+bool isInternalConnector(const std::string& c) {
+    return startsWith(c, "eDP") || startsWith(c, "LVDS") || startsWith(c, "DSI");
+}
+
+} // namespace
+
+std::string DisplayOutput::resolution() const {
+    if (nativeWidth <= 0 || nativeHeight <= 0) return "";
+    return std::to_string(nativeWidth) + "x" + std::to_string(nativeHeight);
+}
+
+double DisplayOutput::diagonalInches() const {
+    if (widthMm <= 0 || heightMm <= 0) return 0.0;
+    double wIn = widthMm / 25.4;
+    double hIn = heightMm / 25.4;
+    return std::sqrt(wIn*wIn + hIn*hIn);
+}
+
+bool parseEdid(const unsigned char* e, size_t size, DisplayOutput& out) {
+    if (size < 128 || !std::equal(kEdidHeader, kEdidHeader + 8, e)) return false;
+
+    unsigned sum = 0;
+    for (int i = 0; i < 128; ++i) sum += e[i];
+    if ((sum & 0xFF) != 0) return false;
+
+    // Manufacturer: three 5-bit letters, big-endian, 'A' == 1.
+    unsigned mfg = (e[8] << 8) | e[9];
+    out.vendor.clear();
+    for (int shift : { 10, 5, 0 }) {
+        unsigned c = (mfg >> shift) & 0x1F;
+        if (c >= 1 && c <= 26) out.vendor.push_back(static_cast<char>('@' + c));
+    }
+    out.productCode = e[10] | (e[11] << 8);
+
+    // Basic display parameters carry the size in whole centimetres; the
+    // detailed timing below, when present, is millimetre-accurate.
+    out.widthMm  = e[21] * 10;
+    out.heightMm = e[22] * 10;
+
+    std::string monitorName, panelText;
+    bool haveTiming = false;
+    for (int off = 54; off <= 108; off += 18) {
+        const unsigned char* d = e + off;
+        unsigned pixelClock = d[0] | (d[1] << 8);    // 10 kHz units
+
+        if (pixelClock != 0) {
+            if (haveTiming) continue;                // first DTD is the preferred mode
+            haveTiming = true;
+
+            int hActive = d[2] | ((d[4] & 0xF0) << 4);
+            int hBlank  = d[3] | ((d[4] & 0x0F) << 8);
+            int vActive = d[5] | ((d[7] & 0xF0) << 4);
+            int vBlank  = d[6] | ((d[7] & 0x0F) << 8);
+            out.nativeWidth  = hActive;
+            out.nativeHeight = vActive;
+
+            long total = long(hActive + hBlank) * long(vActive + vBlank);
+            if (total > 0) out.refreshHz = pixelClock * 10000.0 / total;
+
+            int wMm = d[12] | ((d[14] & 0xF0) << 4);
+            int hMm = d[13] | ((d[14] & 0x0F) << 8);
+            if (wMm > 0 && hMm > 0) {
+                out.widthMm  = wMm;
+                out.heightMm = hMm;
+            }
+            continue;
+        }
+
+        switch (d[3]) {
+        case 0xFC: monitorName = descriptorText(d); break;
+        case 0xFE: if (panelText.empty()) panelText = descriptorText(d); break;
+        default: break;
+        }
+    }
+
+    // Laptop panels rarely set a monitor name but put the model number
+    // (e.g. "B140HAN04.0") in an unspecified-text descriptor.
+    out.name = !monitorName.empty() ? monitorName : panelText;
+    return true;
+}
+
+std::vector<DisplayOutput> enumerateDisplays(const std::string& root) {
+    std::vector<DisplayOutput> outputs;
+
+    for (const auto& entry : listSysDir(root)) {
+        // Connectors are "cardN-<type>-<n>"; skip cards and render nodes.
+        size_t dash = entry.find('-');
+        if (!startsWith(entry, "card") || dash == std::string::npos) continue;
+
+        std::string base = root + "/" + entry;
+        DisplayOutput out;
+        out.connector = entry.substr(dash + 1);
+        out.status    = readSysString(base + "/status");
+        out.enabled   = readSysString(base + "/enabled") == "enabled";
+        out.internal  = isInternalConnector(out.connector);
+        if (out.status != "connected") continue;
+
+        std::vector<unsigned char> edid;
+        if (!readSysBytes(base + "/edid", edid, 32768) || !parseEdid(edid.data(), edid.size(), out))
+            continue;
+        outputs.push_back(std::move(out));
+    }
+
+    std::stable_sort(outputs.begin(), outputs.end(), [](const DisplayOutput& a, const DisplayOutput& b) {
+        if (a.internal != b.internal) return a.internal;
+        return a.connector < b.connector;
+    });
+    return outputs;
+}
@@ -1,33 +1,491 @@
 #include "Log.h"
-#include <fstream>
+#include "LogTail.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
 #include <ctime>
-#include <deque>
+#include <cerrno>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
-void clearLog() {
-    std::ofstream logClear("/tmp/debxray.log", std::ios::trunc);
-    if (!logClear.is_open()) {
-        fprintf(stderr, "Failed to clear /tmp/debxray.log\n");
+namespace {
+
+constexpr char kLogPath[]  = "/tmp/debxray.log";
+constexpr char kJsonPath[] = "/tmp/debxray.jsonl";
+
+constexpr const char* kLevelMarkers[] = { "[*] ", "[+] ", "[-] ", "[!] " };
+
+// How long the writer may sit on queued lines, and how often written
+// lines are forced to disk.
+constexpr auto kFlushInterval = std::chrono::milliseconds(50);
+constexpr auto kSyncInterval  = std::chrono::seconds(1);
+
+using SystemClock = std::chrono::system_clock;
+using SteadyClock = std::chrono::steady_clock;
+
+// Monotonic time base for the JSONL "mono_ms" field.
+const SteadyClock::time_point gStart = SteadyClock::now();
+
+// One queued record, or a request to truncate the logs.
+struct Node {
+    std::atomic<Node*> next{nullptr};
+    LogRecord record;
+    SteadyClock::time_point mono;
+    bool clear = false;
+};
+
+// Lock-free multi-producer/single-consumer queue (Vyukov): producers
+// swap themselves in at `head`, the writer walks from `tail`. Always holds
+// one already-consumed node, so neither end is ever null.
+class LogQueue {
+public:
+    LogQueue() : head(&stub), tail(&stub) {}
+
+    void push(Node* node) {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        Node* prev = head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    // Writer thread only. Returns the next node, or nullptr if the queue is
+    // empty (or a producer is between its two stores; it shows up shortly).
+    // The returned node stays owned by the queue until the following pop.
+    Node* pop() {
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (!next) return nullptr;
+        if (tail != &stub) delete tail;
+        tail = next;
+        return next;
+    }
+
+private:
+    Node stub;
+    std::atomic<Node*> head;
+    Node* tail;
+};
+
+// Newest lines in memory for the viewer, so it never reads the file.
+// Line `seq` sits in slot seq % kLogRingCapacity while first <= seq < next.
+struct LogRing {
+    struct Line {
+        LogRecord record;       // as logged; filters test its typed fields
+        std::string text;       // rendered human line
+        std::string lower;      // for case-insensitive search
+    };
+
+    std::mutex m;
+    std::vector<Line> lines = std::vector<Line>(kLogRingCapacity);
+    uint64_t first = 0;
+    uint64_t next = 0;
+    uint64_t clears = 0;        // bumped by clearLog()
+
+    const Line& at(uint64_t seq) const { return lines[seq % kLogRingCapacity]; }
+
+    // Caller holds `m`. Reuses the slot's storage.
+    void append(const LogRecord& record, std::string_view text) {
+        Line& line = lines[next % kLogRingCapacity];
+        line.record = record;
+        line.text.assign(text.data(), text.size());
+        line.lower.resize(text.size());
+        std::transform(text.begin(), text.end(), line.lower.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (++next - first > kLogRingCapacity) ++first;
+    }
+};
+
+// Never destroyed, like the logger.
+LogRing& ring() {
+    static LogRing* r = new LogRing;
+    return *r;
+}
+
+struct Logger {
+    LogQueue queue;
+    std::atomic<uint64_t> queued{0};
+    std::atomic<bool> wakePending{false};
+
+    std::mutex m;               // guards `written` and the writer's sleep
+    std::condition_variable wake;
+    std::condition_variable drained;
+    uint64_t written = 0;
+
+    int fd = -1;        // human log
+    int jsonFd = -1;    // JSONL sink
+    std::shared_ptr<OwnedRanges> owned = std::make_shared<OwnedRanges>();   // our bytes in `fd`
+};
+
+// Never destroyed: threads may still log while statics are torn down.
+Logger& logger();
+
+void writeAll(int fd, const std::string& data) {
+    size_t off = 0;
+    while (off < data.size()) {
+        ssize_t n = ::write(fd, data.data() + off, data.size() - off);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return;     // disk full or fd gone; drop the batch
+        off += static_cast<size_t>(n);
+    }
+}
+
+// Appends to the human log and records where each write landed, so the
+// tail can tell our lines from other processes'. O_APPEND leaves the file
+// offset at the end of what was just written.
+void writeOwned(Logger& lg, const std::string& data) {
+    std::lock_guard<std::mutex> lock(lg.owned->m);
+    size_t off = 0;
+    while (off < data.size()) {
+        ssize_t n = ::write(lg.fd, data.data() + off, data.size() - off);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return;
+        off_t end = ::lseek(lg.fd, 0, SEEK_CUR);
+        if (end >= n) lg.owned->add(end - n, end);
+        off += static_cast<size_t>(n);
+    }
+}
+
+void appendJsonString(std::string& out, std::string_view text) {
+    out += '"';
+    for (char c : text) {
+        switch (c) {
+        case '"':  out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char esc[8];
+                std::snprintf(esc, sizeof(esc), "\\u%04x", c);
+                out += esc;
+            } else {
+                out += c;
+            }
+        }
+    }
+    out += '"';
+}
+
+// "[ts] [+] source: message key=value ..."; App records carry no source.
+void appendHumanLine(std::string& out, const char* stamp, const LogRecord& n) {
+    out += stamp;
+    out += kLevelMarkers[static_cast<unsigned>(n.level)];
+    if (n.source != LogSource::App) {
+        out += logSourceName(n.source);
+        out += ": ";
+    }
+    out += n.message;
+    for (const auto& [key, value] : n.fields) {
+        out += ' ';
+        out += key;
+        out += '=';
+        out += value;
+    }
+    out += '\n';
+}
+
+void appendJsonLine(std::string& out, const LogRecord& n, SteadyClock::time_point mono) {
+    auto wallMs = std::chrono::duration_cast<std::chrono::milliseconds>(n.when.time_since_epoch()).count();
+    double monoMs = std::chrono::duration<double, std::milli>(mono - gStart).count();
+    char head[96];
+    std::snprintf(head, sizeof(head), "{\"wall_ms\":%lld,\"mono_ms\":%.3f,\"level\":\"%s\",\"source\":\"%s\",\"msg\":",
+                  static_cast<long long>(wallMs), monoMs, logLevelName(n.level), logSourceName(n.source));
+    out += head;
+    appendJsonString(out, n.message);
+    if (!n.fields.empty()) {
+        out += ",\"fields\":{";
+        for (size_t i = 0; i < n.fields.size(); ++i) {
+            if (i) out += ',';
+            appendJsonString(out, n.fields[i].first);
+            out += ':';
+            appendJsonString(out, n.fields[i].second);
+        }
+        out += '}';
+    }
+    out += "}\n";
+}
+
+// Drains the queue into one write() per file per batch. Timestamps are
+// formatted here, once per second of wall time, not at the call site.
+// Each rendered line also goes straight into the viewer's ring.
+void writerLoop(Logger& lg) {
+    std::string batch;
+    std::string jsonBatch;
+    batch.reserve(64 * 1024);
+    jsonBatch.reserve(64 * 1024);
+    std::time_t stampSecond = -1;
+    char stamp[32] = "";
+    auto lastSync = SystemClock::now();
+    bool unsynced = false;
+
+    auto writeBatches = [&] {
+        if (!batch.empty() && lg.fd >= 0) writeOwned(lg, batch);
+        if (!jsonBatch.empty() && lg.jsonFd >= 0) writeAll(lg.jsonFd, jsonBatch);
+        unsynced = unsynced || !batch.empty();
+        batch.clear();
+        jsonBatch.clear();
+    };
+
+    for (;;) {
+        uint64_t done = 0;
+        while (Node* node = lg.queue.pop()) {
+            ++done;
+            if (node->clear) {
+                writeBatches();
+                {
+                    std::lock_guard<std::mutex> lock(lg.owned->m);
+                    for (int fd : { lg.fd, lg.jsonFd }) {
+                        if (fd >= 0 && ftruncate(fd, 0) != 0)
+                            std::fprintf(stderr, "Failed to clear %s\n", fd == lg.fd ? kLogPath : kJsonPath);
+                    }
+                    lg.owned->ranges.clear();
+                    ++lg.owned->truncations;
+                }
+                LogRing& r = ring();
+                std::lock_guard<std::mutex> lock(r.m);
+                r.first = r.next;
+                ++r.clears;
+                continue;
+            }
+
+            const LogRecord& record = node->record;
+            std::time_t t = SystemClock::to_time_t(record.when);
+            if (t != stampSecond) {
+                std::tm tm{};
+                localtime_r(&t, &tm);
+                std::strftime(stamp, sizeof(stamp), "[%Y-%m-%d %H:%M:%S] ", &tm);
+                stampSecond = t;
+            }
+            size_t lineStart = batch.size();
+            appendHumanLine(batch, stamp, record);
+            appendJsonLine(jsonBatch, record, node->mono);
+
+            LogRing& r = ring();
+            std::lock_guard<std::mutex> lock(r.m);
+            r.append(record, std::string_view(batch).substr(lineStart, batch.size() - lineStart - 1));
+        }
+        writeBatches();
+
+        auto now = SystemClock::now();
+        if (unsynced && now - lastSync >= kSyncInterval) {
+            fdatasync(lg.fd);
+            if (lg.jsonFd >= 0) fdatasync(lg.jsonFd);
+            lastSync = now;
+            unsynced = false;
+        }
+
+        std::unique_lock<std::mutex> lock(lg.m);
+        if (done) {
+            lg.written += done;
+            lg.drained.notify_all();
+        }
+        if (lg.written < lg.queued.load(std::memory_order_acquire)) continue;   // mid-push
+        lg.wakePending.store(false, std::memory_order_release);
+        lg.wake.wait_for(lock, kFlushInterval);
     }
 }
 
+void enqueue(Node* node) {
+    Logger& lg = logger();
+    lg.queued.fetch_add(1, std::memory_order_acq_rel);
+    lg.queue.push(node);
+    // Only the first line after the writer went idle pays for a wakeup.
+    if (!lg.wakePending.exchange(true, std::memory_order_acq_rel))
+        lg.wake.notify_one();
+}
+
+Logger& logger() {
+    static Logger* lg = [] {
+        auto* l = new Logger;
+        l->fd = ::open(kLogPath, O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+        if (l->fd < 0) std::fprintf(stderr, "Failed to open %s\n", kLogPath);
+        struct stat st{};
+        if (l->fd >= 0 && ::fstat(l->fd, &st) == 0) l->owned->ino = st.st_ino;
+        l->jsonFd = ::open(kJsonPath, O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+        if (l->jsonFd < 0) std::fprintf(stderr, "Failed to open %s\n", kJsonPath);
+        std::thread(writerLoop, std::ref(*l)).detach();
+        std::atexit(flushLog);
+        return l;
+    }();
+    return *lg;
+}
+
+} // namespace
+
+const char* logLevelName(LogLevel level) {
+    switch (level) {
+    case LogLevel::Success: return "success";
+    case LogLevel::Warning: return "warning";
+    case LogLevel::Error:   return "error";
+    default:                return "info";
+    }
+}
+
+const char* logSourceName(LogSource source) {
+    switch (source) {
+    case LogSource::Probe:    return "probe";
+    case LogSource::Network:  return "net";
+    case LogSource::Packages: return "packages";
+    case LogSource::Cache:    return "cache";
+    case LogSource::Webcam:   return "webcam";
+    case LogSource::External: return "external";
+    default:                  return "app";
+    }
+}
+
+void clearLog() {
+    auto* node = new Node;
+    node->clear = true;
+    enqueue(node);
+    flushLog();     // callers expect an empty log once this returns
+}
+
+void logRecord(LogLevel level, LogSource source, std::string message, LogFields fields) {
+    auto* node = new Node;
+    node->record.when    = SystemClock::now();
+    node->mono           = SteadyClock::now();
+    node->record.level   = level;
+    node->record.source  = source;
+    node->record.message = std::move(message);
+    node->record.fields  = std::move(fields);
+    enqueue(node);
+}
+
 void logMessage(const std::string& message) {
-    std::ofstream logFile("/tmp/debxray.log", std::ios::app);
-    if (!logFile.is_open()) return;
-    std::time_t now = std::time(nullptr);
-    char timeStr[100];
-    std::strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", std::localtime(&now));
-    logFile << "[" << timeStr << "] " << message << std::endl;
+    std::string_view text = message;
+    LogLevel level = LogLevel::Info;
+    for (unsigned l = 0; l < static_cast<unsigned>(LogLevel::Count); ++l) {
+        std::string_view marker = kLevelMarkers[l];
+        if (text.substr(0, marker.size()) == marker) {
+            level = static_cast<LogLevel>(l);
+            text.remove_prefix(marker.size());
+            break;
+        }
+    }
+    logRecord(level, LogSource::App, std::string(text));
+}
+
+void flushLog() {
+    Logger& lg = logger();
+    uint64_t target = lg.queued.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(lg.m);
+    lg.wake.notify_one();
+    lg.drained.wait(lock, [&] { return lg.written >= target; });
+    if (lg.fd >= 0) fdatasync(lg.fd);
+    if (lg.jsonFd >= 0) fdatasync(lg.jsonFd);
 }
 
-std::vector<std::string> readLogTail(int maxLines) {
-    std::ifstream file("/tmp/debxray.log");
-    if (!file.is_open()) return {};
+namespace {
+
+// A line another process appended to the log file. Only such foreign
+// text is ever parsed, and only for its level: a leading "[*]"-style
+// marker, after our timestamp if it has one (another debXray instance or
+// a helper that mimics our format). Its source is External regardless of
+// what follows the marker.
+LogRecord externalRecord(std::string_view line) {
+    LogRecord record;
+    record.when    = SystemClock::now();
+    record.source  = LogSource::External;
+    record.message = std::string(line);
+
+    constexpr size_t kStampLen = 22;   // "[YYYY-mm-dd HH:MM:SS] "
+    if (line.size() > kStampLen && line[0] == '[' && line[kStampLen - 2] == ']')
+        line.remove_prefix(kStampLen);
+    for (unsigned l = 0; l < static_cast<unsigned>(LogLevel::Count); ++l) {
+        std::string_view marker = kLevelMarkers[l];
+        if (line.substr(0, marker.size()) == marker) {
+            record.level = static_cast<LogLevel>(l);
+            break;
+        }
+    }
+    return record;
+}
+
+// Started by the first LogView::update(); other processes' lines join the
+// ring as the External source.
+void followOtherWriters() {
+    static LogTail* tail = [] {
+        Logger& lg = logger();  // creates the file before the tailer looks for it
+        auto* t = new LogTail(kLogPath, lg.owned, [](std::string_view line) {
+            LogRing& r = ring();
+            std::lock_guard<std::mutex> lock(r.m);
+            r.append(externalRecord(line), line);
+        });
+        t->start();
+        return t;
+    }();
+    (void)tail;
+}
+
+} // namespace
+
+void LogView::setFilter(const LogFilter& f) {
+    if (f.levels == filter.levels && f.sources == filter.sources) return;
+    filter  = f;
+    pending = Pending::Rebuild;
+}
+
+void LogView::setQuery(std::string_view q) {
+    std::string lowered(q);
+    std::transform(lowered.begin(), lowered.end(), lowered.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (lowered == query) return;
+    // Every line containing the new query contains the old one too, so the
+    // current matches are a superset; only they need re-testing.
+    bool narrower = lowered.find(query) != std::string::npos;
+    if (pending == Pending::None && narrower) pending = Pending::Narrow;
+    else if (!narrower)                       pending = Pending::Rebuild;
+    query = std::move(lowered);
+}
+
+void LogView::update() {
+    followOtherWriters();
+
+    LogRing& r = ring();
+    std::lock_guard<std::mutex> lock(r.m);
+    auto matchesQuery = [&](uint64_t seq) {
+        return query.empty() || r.at(seq).lower.find(query) != std::string::npos;
+    };
+
+    if (seenClears != r.clears || pending == Pending::Rebuild) {
+        rows.clear();
+        seenSeq = r.first;
+    } else {
+        rows.erase(rows.begin(), std::lower_bound(rows.begin(), rows.end(), r.first));  // overwritten
+        if (pending == Pending::Narrow)
+            rows.erase(std::remove_if(rows.begin(), rows.end(), [&](uint64_t seq) { return !matchesQuery(seq); }),
+                       rows.end());
+    }
+    pending    = Pending::None;
+    seenClears = r.clears;
+
+    for (uint64_t seq = std::max(seenSeq, r.first); seq < r.next; ++seq) {
+        if (filter.matches(r.at(seq).record) && matchesQuery(seq)) rows.push_back(seq);
+    }
+    seenSeq = r.next;
+    total   = static_cast<size_t>(r.next - r.first);
+}
 
-    std::deque<std::string> lines;
-    std::string line;
-    while (std::getline(file, line)) {
-        if (lines.size() >= maxLines) lines.pop_front();
-        lines.push_back(line);
+void LogView::copyRows(size_t first, size_t last, std::vector<std::string>& lines) const {
+    LogRing& r = ring();
+    std::lock_guard<std::mutex> lock(r.m);
+    last = std::min(last, rows.size());
+    first = std::min(first, last);
+    lines.resize(last - first);
+    for (size_t i = first; i < last; ++i) {
+        uint64_t seq = rows[i];
+        // Cleared or overwritten since the last update().
+        if (seenClears != r.clears || seq < r.first || seq >= r.next) {
+            lines[i - first].clear();
+            continue;
+        }
+        lines[i - first].assign(r.at(seq).text);
     }
-    return {lines.begin(), lines.end()};
 }
@@ -0,0 +1,200 @@
+// ----------------------------------------
+// LogTail.cpp
+// ----------------------------------------
+#include "LogTail.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// Also re-checks the file this often, in case inotify is unavailable or
+// the file did not exist yet.
+constexpr int kPollMs = 1000;
+
+constexpr size_t kHeadBytes = 64;
+
+constexpr uint32_t kWatchMask = IN_MODIFY | IN_ATTRIB | IN_DELETE_SELF | IN_MOVE_SELF;
+
+} // namespace
+
+struct LogTail::State {
+    std::shared_ptr<OwnedRanges> owned;
+    LineHandler onLine;
+    std::atomic<bool> stop{false};
+
+    // Tail thread only.
+    int fd = -1;
+    ino_t ino = 0;
+    off_t offset = 0;               // bytes of the file consumed
+    uint64_t truncations = 0;       // owned->truncations last seen
+    std::string partial;            // foreign bytes with no newline yet
+    std::string head;               // first bytes of the file, to spot rewrites
+
+    void restart() {
+        offset = 0;
+        partial.clear();
+        head.clear();
+    }
+
+    // A truncate followed by enough new lines can leave the file longer
+    // than `offset` again; its (timestamped) first bytes will differ.
+    bool sameHead() const {
+        if (head.empty()) return true;
+        char buf[kHeadBytes];
+        ssize_t n = pread(fd, buf, head.size(), 0);
+        return n == static_cast<ssize_t>(head.size()) && head.compare(0, head.size(), buf, n) == 0;
+    }
+
+    // Reads what was appended since `offset`, drops the bytes this process
+    // wrote, and passes on the complete foreign lines.
+    void catchUp() {
+        if (fd < 0) return;
+        off_t size = 0;
+        std::vector<std::pair<off_t, off_t>> mine;
+        {
+            // Appends finish under this lock, so every byte below `size`
+            // that is ours already has its range recorded.
+            std::lock_guard<std::mutex> lock(owned->m);
+            struct stat st{};
+            if (fstat(fd, &st) != 0) return;
+            size = st.st_size;
+            bool ours = owned->ino == st.st_ino;
+            if (ours && owned->truncations != truncations) {
+                truncations = owned->truncations;
+                restart();
+            } else if (size < offset || !sameHead()) {
+                restart();      // truncated or rewritten by someone else
+            }
+            if (size <= offset) return;
+
+            if (ours) {
+                auto& r = owned->ranges;
+                r.erase(r.begin(), std::find_if(r.begin(), r.end(),
+                                                [&](const auto& range) { return range.second > offset; }));
+                for (const auto& range : r) {
+                    if (range.first >= size) break;
+                    mine.push_back(range);
+                }
+            }
+        }
+
+        std::string fresh;
+        char buf[64 * 1024];
+        off_t start = offset;
+        while (offset < size) {
+            ssize_t n = pread(fd, buf, std::min<off_t>(sizeof(buf), size - offset), offset);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) break;
+            offset += n;
+            fresh.append(buf, static_cast<size_t>(n));
+        }
+
+        if (head.size() < kHeadBytes && start == static_cast<off_t>(head.size()))
+            head.append(fresh, 0, std::min(kHeadBytes - head.size(), fresh.size()));
+
+        // Keep only the bytes outside our own appends.
+        std::string foreign;
+        off_t pos = start;
+        for (const auto& range : mine) {
+            off_t from = std::max(range.first, start);
+            if (from > pos) foreign.append(fresh, pos - start, from - pos);
+            pos = std::max(pos, std::min(range.second, offset));
+        }
+        if (offset > pos) foreign.append(fresh, pos - start, offset - pos);
+        if (foreign.empty()) return;
+
+        partial += foreign;
+        size_t begin = 0;
+        for (size_t nl; (nl = partial.find('\n', begin)) != std::string::npos; begin = nl + 1) {
+            if (nl > begin) onLine(std::string_view(partial).substr(begin, nl - begin));
+        }
+        partial.erase(0, begin);
+    }
+
+    // (Re)opens the file, e.g. after it was deleted or rotated. Returns
+    // true if it is a different file than before.
+    bool reopen(const std::string& path, int inotifyFd, int& watch) {
+        int nfd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (nfd < 0) return false;
+        struct stat st{};
+        fstat(nfd, &st);
+        if (fd >= 0 && st.st_ino == ino) {
+            ::close(nfd);
+            if (inotifyFd >= 0 && watch < 0) watch = inotify_add_watch(inotifyFd, path.c_str(), kWatchMask);
+            return false;
+        }
+        if (fd >= 0) ::close(fd);
+        fd  = nfd;
+        ino = st.st_ino;
+        if (inotifyFd >= 0) {
+            if (watch >= 0) inotify_rm_watch(inotifyFd, watch);
+            watch = inotify_add_watch(inotifyFd, path.c_str(), kWatchMask);
+        }
+        return true;
+    }
+};
+
+LogTail::LogTail(std::string path, std::shared_ptr<OwnedRanges> owned, LineHandler onLine)
+: state(std::make_shared<State>()), path(std::move(path)) {
+    state->owned  = std::move(owned);
+    state->onLine = std::move(onLine);
+}
+
+LogTail::~LogTail() {
+    state->stop = true;
+}
+
+void LogTail::start() {
+    // Detached like the connectivity monitor; notices `stop` within one
+    // poll interval and closes its descriptors on the way out.
+    std::thread([st = state, path = path] {
+        int inotifyFd = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+        int watch = -1;
+        if (st->reopen(path, inotifyFd, watch)) st->catchUp();
+
+        alignas(inotify_event) char events[4096];
+        while (!st->stop) {
+            bool replaced = false;
+            if (inotifyFd >= 0 && watch >= 0) {
+                pollfd pfd{ inotifyFd, POLLIN, 0 };
+                if (poll(&pfd, 1, kPollMs) > 0) {
+                    ssize_t n;
+                    while ((n = read(inotifyFd, events, sizeof(events))) > 0) {
+                        for (char* p = events; p < events + n;) {
+                            auto* ev = reinterpret_cast<inotify_event*>(p);
+                            if (ev->wd == watch && (ev->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)))
+                                replaced = true;
+                            p += sizeof(inotify_event) + ev->len;
+                        }
+                    }
+                }
+            } else {
+                std::this_thread::sleep_for(std::chrono::milliseconds(kPollMs));
+            }
+
+            st->catchUp();  // finish the old file before switching
+            if (replaced || watch < 0 || st->fd < 0) {
+                if (replaced) {
+                    inotify_rm_watch(inotifyFd, watch);
+                    watch = -1;
+                }
+                if (st->reopen(path, inotifyFd, watch)) {
+                    st->restart();
+                    st->catchUp();
+                }
+            }
+        }
+
+        if (st->fd >= 0) ::close(st->fd);
+        if (inotifyFd >= 0) ::close(inotifyFd);
+    }).detach();
+}
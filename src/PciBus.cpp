@@ -0,0 +1,304 @@
+// ----------------------------------------
+// PciBus.cpp
+// ----------------------------------------
+#include "PciBus.h"
+#include "SysFs.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// ── pci.ids index file layout
+//   IndexHeader | IndexSlot[slotCount] | NUL-terminated names
+// Open addressing with linear probing. Vendors are keyed as vvvv:ffff,
+// devices as vvvv:dddd.
+constexpr char kIndexMagic[8] = { 'D', 'X', 'P', 'C', 'I', 'I', 'D', '1' };
+constexpr uint32_t kEmpty = 0xFFFFFFFF;
+
+struct IndexHeader {
+    char magic[8];
+    uint64_t srcSize;
+    int64_t srcMtime;
+    uint32_t slotCount;     // power of two
+    uint32_t stringsSize;
+};
+
+struct IndexSlot {
+    uint32_t key;
+    uint32_t nameOff;       // into the string pool, kEmpty if unused
+};
+
+const char* const kPciIdsPaths[] = {
+    "/usr/share/misc/pci.ids",
+    "/usr/share/hwdata/pci.ids",
+    "/usr/share/pci.ids",
+    "/var/lib/pciutils/pci.ids",
+};
+
+const char* const kIndexPaths[] = {
+    "/var/cache/debxray/pci.ids.idx",
+    "/tmp/debxray-pci.ids.idx",
+};
+
+uint32_t vendorKey(uint16_t v)             { return (uint32_t(v) << 16) | 0xFFFF; }
+uint32_t deviceKey(uint16_t v, uint16_t d) { return (uint32_t(v) << 16) | d; }
+
+uint32_t hashKey(uint32_t key, uint32_t slotCount) {
+    return (key * 2654435761u) & (slotCount - 1);
+}
+
+bool parseId(std::string_view s, uint16_t& out) {
+    if (s.size() < 4) return false;
+    unsigned long v = 0;
+    if (!parseHex(s.substr(0, 4), v)) return false;
+    out = static_cast<uint16_t>(v);
+    return true;
+}
+
+// Builds the index image from the text of pci.ids. Only the vendor and
+// device levels are indexed; subsystems and the class section are skipped.
+std::vector<unsigned char> buildIndex(std::string_view text, const struct stat& src) {
+    std::vector<std::pair<uint32_t, std::string_view>> entries;
+    entries.reserve(40000);
+
+    uint16_t vendor = 0;
+    bool inVendor = false;
+    std::string_view line;
+    while (nextLine(text, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        if (startsWith(line, "C ")) break;          // class list follows vendors
+
+        uint16_t id;
+        if (line[0] != '\t') {
+            inVendor = parseId(line, vendor);
+            if (inVendor) entries.emplace_back(vendorKey(vendor), trimView(line.substr(4)));
+        } else if (inVendor && line.size() > 1 && line[1] != '\t') {
+            if (parseId(line.substr(1), id) && id != 0xFFFF)
+                entries.emplace_back(deviceKey(vendor, id), trimView(line.substr(5)));
+        }
+    }
+
+    uint32_t slotCount = 1;
+    while (slotCount < entries.size() * 2) slotCount <<= 1;
+
+    std::vector<IndexSlot> slots(slotCount, IndexSlot{ 0, kEmpty });
+    std::string pool;
+    for (const auto& [key, name] : entries) {
+        uint32_t i = hashKey(key, slotCount);
+        while (slots[i].nameOff != kEmpty && slots[i].key != key) i = (i + 1) & (slotCount - 1);
+        if (slots[i].nameOff != kEmpty) continue;   // duplicate id, first wins
+        slots[i] = { key, static_cast<uint32_t>(pool.size()) };
+        pool.append(name);
+        pool.push_back('\0');
+    }
+
+    IndexHeader hdr{};
+    std::memcpy(hdr.magic, kIndexMagic, sizeof(kIndexMagic));
+    hdr.srcSize     = static_cast<uint64_t>(src.st_size);
+    hdr.srcMtime    = static_cast<int64_t>(src.st_mtime);
+    hdr.slotCount   = slotCount;
+    hdr.stringsSize = static_cast<uint32_t>(pool.size());
+
+    std::vector<unsigned char> image(sizeof(hdr) + slots.size() * sizeof(IndexSlot) + pool.size());
+    unsigned char* p = image.data();
+    std::memcpy(p, &hdr, sizeof(hdr));                      p += sizeof(hdr);
+    std::memcpy(p, slots.data(), slots.size() * sizeof(IndexSlot)); p += slots.size() * sizeof(IndexSlot);
+    std::memcpy(p, pool.data(), pool.size());
+    return image;
+}
+
+bool validIndex(const unsigned char* data, size_t size, const struct stat* src) {
+    if (size < sizeof(IndexHeader)) return false;
+    IndexHeader hdr;
+    std::memcpy(&hdr, data, sizeof(hdr));
+    if (std::memcmp(hdr.magic, kIndexMagic, sizeof(kIndexMagic)) != 0) return false;
+    if (hdr.slotCount == 0 || (hdr.slotCount & (hdr.slotCount - 1)) != 0) return false;
+    if (sizeof(hdr) + uint64_t(hdr.slotCount) * sizeof(IndexSlot) + hdr.stringsSize != size) return false;
+    if (src && (hdr.srcSize != uint64_t(src->st_size) || hdr.srcMtime != int64_t(src->st_mtime)))
+        return false;
+    return true;
+}
+
+// With `ownedOnly` (our own index files, which may sit in /tmp), refuses
+// symlinks and anything not a regular file owned by us and writable only
+// by us, so another user can't plant an index we would trust.
+bool mapFile(const char* path, const unsigned char*& data, size_t& size, bool ownedOnly = false) {
+    int fd = ::open(path, O_RDONLY | O_CLOEXEC | (ownedOnly ? O_NOFOLLOW : 0));
+    if (fd < 0) return false;
+    struct stat st;
+    bool ok = ::fstat(fd, &st) == 0 && st.st_size > 0;
+    if (ok && ownedOnly)
+        ok = S_ISREG(st.st_mode) && st.st_uid == ::geteuid() && (st.st_mode & (S_IWGRP | S_IWOTH)) == 0;
+    if (!ok) {
+        ::close(fd);
+        return false;
+    }
+    void* p = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) return false;
+    data = static_cast<const unsigned char*>(p);
+    size = static_cast<size_t>(st.st_size);
+    return true;
+}
+
+bool writeIndex(const char* path, const std::vector<unsigned char>& image) {
+    std::string dir(path, std::strrchr(path, '/') - path);
+    ::mkdir(dir.c_str(), 0755);
+
+    // mkstemp creates a fresh file (O_EXCL), so a pre-planted name or
+    // symlink can't redirect the write; rename() then replaces `path`
+    // itself, never what a symlink there points to.
+    std::string tmp = std::string(path) + ".XXXXXX";
+    int fd = ::mkstemp(tmp.data());
+    if (fd < 0) return false;
+    bool ok = ::fchmod(fd, 0644) == 0 &&
+              ::write(fd, image.data(), image.size()) == static_cast<ssize_t>(image.size());
+    ::close(fd);
+    if (!ok || ::rename(tmp.c_str(), path) != 0) {
+        ::unlink(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+// ── PciIds
+
+const PciIds& PciIds::instance() {
+    static const PciIds ids;
+    return ids;
+}
+
+PciIds::PciIds() {
+    const char* srcPath = nullptr;
+    struct stat src;
+    for (const char* p : kPciIdsPaths) {
+        if (::stat(p, &src) == 0) {
+            srcPath = p;
+            break;
+        }
+    }
+    if (!srcPath) return;
+
+    // Fast path: an index built from this exact pci.ids already exists.
+    for (const char* idx : kIndexPaths) {
+        const unsigned char* data;
+        size_t size;
+        if (!mapFile(idx, data, size, true)) continue;
+        if (validIndex(data, size, &src)) {
+            map = data;
+            mapSize = size;
+            mapped = true;
+            return;
+        }
+        ::munmap(const_cast<unsigned char*>(data), size);
+    }
+
+    const unsigned char* text;
+    size_t textSize;
+    if (!mapFile(srcPath, text, textSize)) return;
+    std::vector<unsigned char> image =
+        buildIndex(std::string_view(reinterpret_cast<const char*>(text), textSize), src);
+    ::munmap(const_cast<unsigned char*>(text), textSize);
+
+    for (const char* idx : kIndexPaths) {
+        if (!writeIndex(idx, image)) continue;
+        const unsigned char* data;
+        size_t size;
+        if (mapFile(idx, data, size, true) && validIndex(data, size, &src)) {
+            map = data;
+            mapSize = size;
+            mapped = true;
+            return;
+        }
+    }
+
+    // Read-only system: keep the index on the heap for this run.
+    owned = std::move(image);
+    map = owned.data();
+    mapSize = owned.size();
+}
+
+PciIds::~PciIds() {
+    if (mapped) ::munmap(const_cast<unsigned char*>(map), mapSize);
+}
+
+const char* PciIds::lookup(uint32_t key) const {
+    if (!map) return nullptr;
+    IndexHeader hdr;
+    std::memcpy(&hdr, map, sizeof(hdr));
+    const auto* slots = reinterpret_cast<const IndexSlot*>(map + sizeof(hdr));
+    const char* pool  = reinterpret_cast<const char*>(map + sizeof(hdr) + hdr.slotCount * sizeof(IndexSlot));
+
+    uint32_t i = hashKey(key, hdr.slotCount);
+    for (uint32_t probes = 0; probes < hdr.slotCount; ++probes) {
+        const IndexSlot& s = slots[i];
+        if (s.nameOff == kEmpty) return nullptr;
+        if (s.key == key) return s.nameOff < hdr.stringsSize ? pool + s.nameOff : nullptr;
+        i = (i + 1) & (hdr.slotCount - 1);
+    }
+    return nullptr;
+}
+
+std::string PciIds::vendor(uint16_t vendorId) const {
+    const char* name = lookup(vendorKey(vendorId));
+    return name ? name : "";
+}
+
+std::string PciIds::device(uint16_t vendorId, uint16_t deviceId) const {
+    const char* name = lookup(deviceKey(vendorId, deviceId));
+    return name ? name : "";
+}
+
+// ── Enumeration
+
+std::string PciDevice::displayName() const {
+    if (!vendorName.empty() && !deviceName.empty()) return vendorName + " " + deviceName;
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "[%04x:%04x]", vendorId, deviceId);
+    return vendorName.empty() ? buf : vendorName + " " + buf;
+}
+
+std::vector<PciDevice> enumeratePci(const std::string& root) {
+    std::vector<PciDevice> devices;
+    const PciIds& ids = PciIds::instance();
+
+    for (const auto& slot : listSysDir(root)) {
+        // uevent carries class, ids and driver in a single read.
+        char buf[512];
+        std::string_view uevent = readSysFile(root + "/" + slot + "/uevent", buf);
+        if (uevent.empty()) continue;
+
+        PciDevice d;
+        d.slot   = slot;
+        d.driver = std::string(findField(uevent, "DRIVER", '='));
+
+        unsigned long cls = 0;
+        parseHex(findField(uevent, "PCI_CLASS", '='), cls);
+        d.classCode = static_cast<uint32_t>(cls);
+
+        std::string_view id = findField(uevent, "PCI_ID", '=');   // "8086:5917"
+        unsigned long v = 0, dev = 0;
+        size_t colon = id.find(':');
+        if (colon == std::string_view::npos ||
+            !parseHex(id.substr(0, colon), v) || !parseHex(id.substr(colon + 1), dev))
+            continue;
+        d.vendorId = static_cast<uint16_t>(v);
+        d.deviceId = static_cast<uint16_t>(dev);
+
+        d.vendorName = ids.vendor(d.vendorId);
+        d.deviceName = ids.device(d.vendorId, d.deviceId);
+        devices.push_back(std::move(d));
+    }
+
+    std::sort(devices.begin(), devices.end(),
+              [](const PciDevice& a, const PciDevice& b) { return a.slot < b.slot; });
+    return devices;
+}
@@ -0,0 +1,82 @@
+// ----------------------------------------
+// PowerSupply.cpp
+// ----------------------------------------
+#include "PowerSupply.h"
+#include "SysFs.h"
+#include <algorithm>
+
+double BatteryInfo::healthPercent() const {
+    if (full <= 0.0 || fullDesign <= 0.0) return -1.0;
+    return full / fullDesign * 100.0;
+}
+
+std::vector<BatteryInfo> enumerateBatteries(const std::string& root) {
+    std::vector<BatteryInfo> batteries;
+
+    for (const auto& name : listSysDir(root)) {
+        std::string dir = root + "/" + name;
+        // `type` is always there; uevent only carries POWER_SUPPLY_TYPE
+        // since Linux 5.8, so older kernels would hide every battery.
+        char typeBuf[32];
+        if (trimView(readSysFile(dir + "/type", typeBuf)) != "Battery") continue;
+
+        // uevent has every other attribute of the supply in one read.
+        char buf[2048];
+        std::string_view uevent = readSysFile(dir + "/uevent", buf);
+        if (findField(uevent, "POWER_SUPPLY_SCOPE", '=') == "Device") continue;
+
+        BatteryInfo b;
+        b.name         = name;
+        b.manufacturer = std::string(findField(uevent, "POWER_SUPPLY_MANUFACTURER", '='));
+        b.model        = std::string(findField(uevent, "POWER_SUPPLY_MODEL_NAME", '='));
+        b.status       = std::string(findField(uevent, "POWER_SUPPLY_STATUS", '='));
+
+        long full = 0, design = 0;
+        if (parseLong(findField(uevent, "POWER_SUPPLY_ENERGY_FULL", '='), full) &&
+            parseLong(findField(uevent, "POWER_SUPPLY_ENERGY_FULL_DESIGN", '='), design)) {
+            b.chargeUnits = false;
+        } else if (parseLong(findField(uevent, "POWER_SUPPLY_CHARGE_FULL", '='), full) &&
+                   parseLong(findField(uevent, "POWER_SUPPLY_CHARGE_FULL_DESIGN", '='), design)) {
+            b.chargeUnits = true;
+        }
+        b.full       = static_cast<double>(full);
+        b.fullDesign = static_cast<double>(design);
+
+        long v = 0;
+        if (parseLong(findField(uevent, "POWER_SUPPLY_CYCLE_COUNT", '='), v)) b.cycleCount = v;
+        if (parseLong(findField(uevent, "POWER_SUPPLY_CAPACITY", '='), v))    b.chargePercent = static_cast<int>(v);
+
+        batteries.push_back(std::move(b));
+    }
+
+    std::sort(batteries.begin(), batteries.end(),
+              [](const BatteryInfo& a, const BatteryInfo& b) { return a.name < b.name; });
+    return batteries;
+}
+
+double combinedBatteryHealth(const std::vector<BatteryInfo>& batteries) {
+    // Sum capacities when every pack reports the same units (dual-battery
+    // ThinkPads); otherwise average the per-pack ratios.
+    double full = 0.0, design = 0.0, ratioSum = 0.0;
+    int known = 0;
+    bool sameUnits = true, firstChargeUnits = false;
+    for (const auto& b : batteries) {
+        double h = b.healthPercent();
+        if (h < 0.0) continue;
+        if (known == 0) firstChargeUnits = b.chargeUnits;
+        else if (b.chargeUnits != firstChargeUnits) sameUnits = false;
+        full     += b.full;
+        design   += b.fullDesign;
+        ratioSum += h;
+        ++known;
+    }
+    if (known == 0) return -1.0;
+    return sameUnits ? full / design * 100.0 : ratioSum / known;
+}
+
+std::string gradeBatteryHealth(double health) {
+    if (health < 0.0)    return "N/A";
+    if (health >= 90.0)  return "Excellent";
+    if (health >= 70.0)  return "Good";
+    return "Poor";
+}
@@ -0,0 +1,250 @@
+// ----------------------------------------
+// ProbeCache.cpp
+// ----------------------------------------
+#include "ProbeCache.h"
+#include "Smbios.h"
+#include "SysFs.h"
+#include "Log.h"
+#include "json.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using json = nlohmann::json;
+
+namespace {
+
+// Root-only: nothing else on the station may plant or edit entries that
+// are shown as probe results. Non-root runs have no cache key anyway.
+constexpr char kCacheDir[]  = "/var/cache/debxray";
+constexpr char kCachePath[] = "/var/cache/debxray/probe-cache.json";
+
+// Bumped whenever the file's layout changes; a mismatch starts it over.
+constexpr int kCacheFormat = 2;
+
+// Stamped on every entry and bumped whenever the stored fields or how a
+// probe computes them change (e.g. a new CPU name parser), so entries
+// written by an older build read as misses instead of stale answers.
+constexpr int kEntrySchema = 1;
+
+// A station sees many machines; keep the most recently updated ones.
+constexpr size_t kMaxEntries = 64;
+
+bool placeholderSerial(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(), ::tolower);
+    return s.empty() || s == "0" || s == "none" || s == "default string" ||
+           s.find("to be filled") != std::string::npos || s.find("system serial") != std::string::npos;
+}
+
+// Every cached section must have a complete result behind it: a section
+// that timed out, threw, was disabled or ran without root still holds its
+// defaults (or part of an answer), and caching that would stop it from
+// ever being probed again on this machine.
+bool cacheable(const SystemInfo& info) {
+    for (unsigned s = 0; s < static_cast<unsigned>(ProbeSection::Count); ++s) {
+        ProbeSection section = static_cast<ProbeSection>(s);
+        if (!(kCachedSections & probeBit(section))) continue;
+        auto t = std::find_if(info.timings.begin(), info.timings.end(),
+                              [&](const ProbeTiming& t) { return t.section == probeSectionName(section); });
+        if (t == info.timings.end()) return false;
+        if (t->cached) continue;
+        if (t->timedOut || t->failed || t->disabled || t->unprivileged) return false;
+    }
+    return true;
+}
+
+json panelToJson(const DisplayOutput& d) {
+    return {{"connector", d.connector},
+            {"vendor", d.vendor},
+            {"product_code", d.productCode},
+            {"name", d.name},
+            {"width", d.nativeWidth},
+            {"height", d.nativeHeight},
+            {"refresh_hz", d.refreshHz},
+            {"width_mm", d.widthMm},
+            {"height_mm", d.heightMm}};
+}
+
+// The live internal panel, if the Display probe read one.
+const DisplayOutput* livePanel(const SystemInfo& info) {
+    for (const auto& d : info.displays) {
+        if (d.internal && d.status != "cached") return &d;
+    }
+    return nullptr;
+}
+
+// Owned by root and writable by nobody else.
+bool trusted(const struct stat& st) {
+    return st.st_uid == 0 && (st.st_mode & (S_IWGRP | S_IWOTH)) == 0;
+}
+
+bool trustedDir() {
+    struct stat st;
+    return ::lstat(kCacheDir, &st) == 0 && S_ISDIR(st.st_mode) && trusted(st);
+}
+
+json emptyCache() {
+    return json{{"format", kCacheFormat}, {"machines", json::object()}};
+}
+
+json loadFile() {
+    if (!trustedDir()) return emptyCache();
+    int fd = ::open(kCachePath, O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+    if (fd < 0) return emptyCache();
+
+    std::string text;
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && trusted(st)) {
+        char buf[8192];
+        ssize_t n;
+        while ((n = ::read(fd, buf, sizeof(buf))) > 0) text.append(buf, static_cast<size_t>(n));
+    }
+    ::close(fd);
+
+    json root = json::parse(text, nullptr, false);
+    if (root.is_object() && root.value("format", 0) == kCacheFormat) return root;
+    return emptyCache();
+}
+
+bool writeFile(const std::string& text) {
+    if (::geteuid() != 0) return false;
+    ::mkdir(kCacheDir, 0755);
+    if (!trustedDir()) return false;
+
+    // mkstemp creates a fresh file (O_EXCL), and rename() replaces the
+    // cache path itself, never what a symlink there points to.
+    std::string tmp = std::string(kCachePath) + ".XXXXXX";
+    int fd = ::mkstemp(tmp.data());
+    if (fd < 0) return false;
+    bool ok = ::fchmod(fd, 0644) == 0 &&
+              ::write(fd, text.data(), text.size()) == static_cast<ssize_t>(text.size());
+    ::close(fd);
+    if (!ok || ::rename(tmp.c_str(), kCachePath) != 0) {
+        ::unlink(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+std::string machineCacheKey() {
+    std::string uuid, serial;
+    SmbiosInfo smbios;
+    if (readSmbios(smbios)) {
+        uuid   = smbios.uuid;
+        serial = smbios.serial;
+    } else {
+        uuid   = readSysString("/sys/class/dmi/id/product_uuid");     // root-only
+        serial = readSysString("/sys/class/dmi/id/product_serial");
+        std::transform(uuid.begin(), uuid.end(), uuid.begin(), ::tolower);
+        if (uuid == "00000000-0000-0000-0000-000000000000" ||
+            uuid == "ffffffff-ffff-ffff-ffff-ffffffffffff")
+            uuid.clear();
+    }
+    if (placeholderSerial(serial)) serial.clear();
+
+    // Either alone is too weak: cloned UUIDs and blank serials are common.
+    if (uuid.empty() || serial.empty()) return "";
+    return uuid + "/" + serial;
+}
+
+bool loadProbeCache(const std::string& key, SystemInfo& info, DisplayOutput& panel) {
+    panel = DisplayOutput{};
+    if (key.empty()) return false;
+    json root = loadFile();
+    auto it = root["machines"].find(key);
+    if (it == root["machines"].end() || it->value("schema", 0) != kEntrySchema) return false;
+
+    try {
+        const json& e = *it;
+        info.cpuBrand     = e.at("cpu_brand").get<std::string>();
+        info.cpuModel     = e.at("cpu_model").get<std::string>();
+        info.cpuSpeed     = e.at("cpu_speed").get<std::string>();
+        info.physicalCPUs = e.at("physical_cpus").get<std::string>();
+        info.gpu          = e.at("gpu").get<std::string>();
+        info.pciDevices   = e.at("pci_devices").get<std::vector<std::string>>();
+
+        if (e.contains("panel")) {
+            const json& d = e.at("panel");
+            panel.connector    = d.at("connector").get<std::string>();
+            panel.status       = "cached";
+            panel.internal     = true;
+            panel.vendor       = d.at("vendor").get<std::string>();
+            panel.productCode  = d.at("product_code").get<unsigned>();
+            panel.name         = d.at("name").get<std::string>();
+            panel.nativeWidth  = d.at("width").get<int>();
+            panel.nativeHeight = d.at("height").get<int>();
+            panel.refreshHz    = d.at("refresh_hz").get<double>();
+            panel.widthMm      = d.at("width_mm").get<int>();
+            panel.heightMm     = d.at("height_mm").get<int>();
+        }
+    } catch (const json::exception& e) {
+        logRecord(LogLevel::Warning, LogSource::Cache, "Ignoring malformed probe cache entry: " + std::string(e.what()));
+        panel = DisplayOutput{};
+        return false;
+    }
+    return true;
+}
+
+bool sameCachedFields(const SystemInfo& a, const SystemInfo& b) {
+    return a.cpuBrand == b.cpuBrand && a.cpuModel == b.cpuModel && a.cpuSpeed == b.cpuSpeed &&
+           a.physicalCPUs == b.physicalCPUs && a.gpu == b.gpu && a.pciDevices == b.pciDevices;
+}
+
+void applyCachedPanel(SystemInfo& info, const DisplayOutput& panel) {
+    if (panel.connector.empty() || livePanel(info)) return;
+    info.displays.insert(info.displays.begin(), panel);
+
+    info.resolution = panel.resolution();
+    if (info.resolution.empty()) info.resolution = "Unknown";
+    double diag = panel.diagonalInches();
+    if (diag > 0.0) {
+        char size[16];
+        std::snprintf(size, sizeof(size), "%.1f\"", diag);
+        info.screenSize = size;
+    } else {
+        info.screenSize = "Unknown";
+    }
+}
+
+void saveProbeCache(const std::string& key, const SystemInfo& info) {
+    if (key.empty() || !cacheable(info)) return;
+
+    json entry = {{"schema", kEntrySchema},
+                  {"cpu_brand", info.cpuBrand},
+                  {"cpu_model", info.cpuModel},
+                  {"cpu_speed", info.cpuSpeed},
+                  {"physical_cpus", info.physicalCPUs},
+                  {"gpu", info.gpu},
+                  {"pci_devices", info.pciDevices}};
+
+    json root = loadFile();
+    json& machines = root["machines"];
+    json previous = machines.contains(key) ? machines[key] : json::object();
+    previous.erase("saved");
+
+    // A pass that didn't see the panel keeps the one read earlier.
+    if (const DisplayOutput* panel = livePanel(info)) entry["panel"] = panelToJson(*panel);
+    else if (previous.contains("panel"))              entry["panel"] = previous["panel"];
+
+    if (entry == previous) return;
+    entry["saved"] = static_cast<long long>(std::time(nullptr));
+    machines[key] = std::move(entry);
+
+    while (machines.size() > kMaxEntries) {
+        auto oldest = machines.begin();
+        for (auto it = machines.begin(); it != machines.end(); ++it) {
+            if (it->value("saved", 0LL) < oldest->value("saved", 0LL)) oldest = it;
+        }
+        machines.erase(oldest);
+    }
+
+    if (!writeFile(root.dump()))
+        logRecord(LogLevel::Warning, LogSource::Cache, "Could not write the probe cache.", {{"path", kCachePath}});
+}
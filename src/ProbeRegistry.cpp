@@ -0,0 +1,112 @@
+// ----------------------------------------
+// ProbeRegistry.cpp
+// ----------------------------------------
+#include "ProbeRegistry.h"
+#include "SysFs.h"
+#include "Log.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+constexpr char kConfigPath[] = "/etc/debxray/probes.conf";
+
+// Built-ins first, so a later registerProbe() can replace one.
+std::vector<ProbeDescriptor>& registry() {
+    static std::vector<ProbeDescriptor> probes = [] {
+        std::vector<ProbeDescriptor> builtins = builtinProbes();
+        std::sort(builtins.begin(), builtins.end(),
+                  [](const ProbeDescriptor& a, const ProbeDescriptor& b) { return a.section < b.section; });
+        return builtins;
+    }();
+    return probes;
+}
+
+} // namespace
+
+void registerProbe(ProbeDescriptor probe) {
+    auto& probes = registry();
+    auto it = std::find_if(probes.begin(), probes.end(),
+                           [&](const ProbeDescriptor& p) { return p.section == probe.section; });
+    if (it != probes.end()) {
+        *it = std::move(probe);
+        return;
+    }
+    auto pos = std::upper_bound(probes.begin(), probes.end(), probe.section,
+                                [](ProbeSection s, const ProbeDescriptor& p) { return s < p.section; });
+    probes.insert(pos, std::move(probe));
+}
+
+const std::vector<ProbeDescriptor>& probeRegistry() {
+    return registry();
+}
+
+const ProbeDescriptor* findProbe(ProbeSection section) {
+    for (const auto& p : probeRegistry()) {
+        if (p.section == section) return &p;
+    }
+    return nullptr;
+}
+
+std::vector<const ProbeDescriptor*> probeRunOrder(ProbeMask sections) {
+    std::vector<const ProbeDescriptor*> order;
+    for (const auto& p : probeRegistry()) {
+        if (sections & probeBit(p.section)) order.push_back(&p);
+    }
+    std::stable_sort(order.begin(), order.end(), [](const ProbeDescriptor* a, const ProbeDescriptor* b) {
+        if (a->critical != b->critical) return a->critical;
+        return a->cost < b->cost;
+    });
+
+    // Pull each probe ahead of the first one that depends on it. Deps on
+    // sections outside `sections` are ignored; a cycle keeps sorted order.
+    std::vector<const ProbeDescriptor*> sorted;
+    sorted.reserve(order.size());
+    ProbeMask placed = 0;
+    while (!order.empty()) {
+        auto ready = std::find_if(order.begin(), order.end(), [&](const ProbeDescriptor* p) {
+            return (p->dependsOn & sections & ~placed) == 0;
+        });
+        if (ready == order.end()) ready = order.begin();
+        placed |= probeBit((*ready)->section);
+        sorted.push_back(*ready);
+        order.erase(ready);
+    }
+    return sorted;
+}
+
+ProbeMask disabledProbes() {
+    static const ProbeMask disabled = [] {
+        ProbeMask mask = 0;
+        std::ifstream in(kConfigPath);
+        std::string line;
+        while (std::getline(in, line)) {
+            std::string_view view = trimView(line);
+            if (view.empty() || view[0] == '#') continue;
+            size_t eq = view.find('=');
+            if (eq == std::string_view::npos || trimView(view.substr(0, eq)) != "disable") continue;
+
+            std::string names(view.substr(eq + 1));
+            std::replace(names.begin(), names.end(), ',', ' ');
+            std::istringstream words(names);
+            std::string name;
+            while (words >> name) {
+                bool known = false;
+                for (unsigned s = 0; s < static_cast<unsigned>(ProbeSection::Count); ++s) {
+                    ProbeSection section = static_cast<ProbeSection>(s);
+                    if (name == probeSectionName(section)) {
+                        mask |= probeBit(section);
+                        known = true;
+                    }
+                }
+                if (known) logRecord(LogLevel::Info, LogSource::Probe, "Probe disabled by " + std::string(kConfigPath) + ".",
+                                     {{"probe", name}});
+                else       logRecord(LogLevel::Warning, LogSource::Probe, "Unknown probe in " + std::string(kConfigPath) + ".",
+                                     {{"probe", name}});
+            }
+        }
+        return mask;
+    }();
+    return disabled;
+}
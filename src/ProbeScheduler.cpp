@@ -0,0 +1,227 @@
+// ----------------------------------------
+// ProbeScheduler.cpp
+// ----------------------------------------
+#include "ProbeScheduler.h"
+#include "Log.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+thread_local unsigned tlsSpawns = 0;
+std::atomic<AllocationCounter> gAllocationCounter{nullptr};
+
+uint64_t allocationsSoFar() {
+    AllocationCounter counter = gAllocationCounter.load(std::memory_order_relaxed);
+    return counter ? counter() : 0;
+}
+
+enum class SlotState { Pending, Running, Done, Failed, Abandoned };
+
+struct Slot {
+    std::string name;
+    std::chrono::milliseconds deadline;
+    ProbeScheduler::Work work;
+    std::vector<size_t> after;
+    SlotState state = SlotState::Pending;
+    Clock::time_point started;
+    Clock::time_point finished;
+    unsigned spawns = 0;
+    uint64_t allocations = 0;
+    SystemInfo partial;
+};
+
+// Shared between run() and the workers. Workers hold a shared_ptr so an
+// abandoned worker can finish (or hang) long after run() has returned.
+struct Shared {
+    std::mutex m;
+    std::condition_variable cv;
+    std::vector<Slot> slots;
+};
+
+bool settledState(SlotState s) {
+    return s == SlotState::Done || s == SlotState::Failed || s == SlotState::Abandoned;
+}
+
+bool hasPending(const Shared& shared) {
+    for (const auto& slot : shared.slots) {
+        if (slot.state == SlotState::Pending) return true;
+    }
+    return false;
+}
+
+// First pending slot whose dependencies have all settled; nullptr if none
+// is runnable yet. Slots are in priority order, so this is also the most
+// urgent runnable task.
+Slot* nextRunnable(Shared& shared) {
+    for (auto& slot : shared.slots) {
+        if (slot.state != SlotState::Pending) continue;
+        bool ready = std::all_of(slot.after.begin(), slot.after.end(),
+                                 [&](size_t dep) { return settledState(shared.slots[dep].state); });
+        if (ready) return &slot;
+    }
+    return nullptr;
+}
+
+void workerLoop(std::shared_ptr<Shared> shared) {
+    std::unique_lock<std::mutex> lock(shared->m);
+    while (hasPending(*shared)) {
+        Slot* next = nextRunnable(*shared);
+        if (!next) {
+            shared->cv.wait(lock);  // a dependency is still running
+            continue;
+        }
+        Slot& slot = *next;
+        slot.state   = SlotState::Running;
+        slot.started = Clock::now();
+        shared->cv.notify_all();    // run() needs the start time for the deadline
+        ProbeScheduler::Work work = slot.work;
+        lock.unlock();
+
+        SystemInfo partial;
+        unsigned spawnsBefore = tlsSpawns;
+        uint64_t allocsBefore = allocationsSoFar();
+        bool ok = true;
+        try {
+            work(partial);
+        } catch (const std::exception& e) {
+            logRecord(LogLevel::Error, LogSource::Probe, "Probe failed: " + std::string(e.what()),
+                      {{"probe", slot.name}});
+            ok = false;
+        } catch (...) {
+            ok = false;
+        }
+
+        auto finished = Clock::now();
+        unsigned spawns = tlsSpawns - spawnsBefore;
+        uint64_t allocations = allocationsSoFar() - allocsBefore;
+
+        lock.lock();
+        if (slot.state == SlotState::Abandoned) {
+            // run() has already given up on this task and started a
+            // replacement worker; retire quietly.
+            return;
+        }
+        if (ok) slot.partial = std::move(partial);
+        slot.finished = finished;
+        slot.spawns   = spawns;
+        slot.allocations = allocations;
+        slot.state    = ok ? SlotState::Done : SlotState::Failed;
+        shared->cv.notify_all();
+    }
+}
+
+void spawnWorker(const std::shared_ptr<Shared>& shared) {
+    std::thread(workerLoop, shared).detach();
+}
+
+} // namespace
+
+void noteProbeSpawn() {
+    ++tlsSpawns;
+}
+
+void setProbeAllocationCounter(AllocationCounter counter) {
+    gAllocationCounter.store(counter, std::memory_order_relaxed);
+}
+
+ProbeScheduler::ProbeScheduler(unsigned workers)
+: workers(workers ? workers : std::max(4u, std::thread::hardware_concurrency())) {}
+
+void ProbeScheduler::add(std::string name, std::chrono::milliseconds deadline, Work work, Merge merge,
+                         std::vector<size_t> after) {
+    // Only earlier tasks can be waited on, which rules out cycles.
+    after.erase(std::remove_if(after.begin(), after.end(), [&](size_t dep) { return dep >= tasks.size(); }),
+                after.end());
+    tasks.push_back({ std::move(name), deadline, std::move(work), std::move(merge), std::move(after) });
+}
+
+void ProbeScheduler::run(SystemInfo& out, const Settled& onSettled) {
+    if (tasks.empty()) return;
+
+    auto shared = std::make_shared<Shared>();
+    shared->slots.reserve(tasks.size());
+    for (const auto& t : tasks) {
+        Slot s;
+        s.name     = t.name;
+        s.deadline = t.deadline;
+        s.work     = t.work;
+        s.after    = t.after;
+        shared->slots.push_back(std::move(s));
+    }
+
+    size_t poolSize = std::min<size_t>(workers, tasks.size());
+    for (size_t i = 0; i < poolSize; ++i) spawnWorker(shared);
+
+    std::vector<bool> settled(tasks.size(), false);
+    size_t remaining = tasks.size();
+
+    std::unique_lock<std::mutex> lock(shared->m);
+    while (remaining > 0) {
+        auto now = Clock::now();
+        auto wakeAt = Clock::time_point::max();
+        bool progressed = false;
+
+        for (size_t i = 0; i < shared->slots.size(); ++i) {
+            if (settled[i]) continue;
+            Slot& slot = shared->slots[i];
+            size_t before = remaining;
+            TaskStats stats;
+
+            switch (slot.state) {
+            case SlotState::Done:
+                tasks[i].merge(out, slot.partial);
+                settled[i] = true;
+                --remaining;
+                break;
+            case SlotState::Failed:
+                logRecord(LogLevel::Warning, LogSource::Probe, "Probe failed; using defaults.", {{"probe", slot.name}});
+                stats.failed = true;
+                settled[i] = true;
+                --remaining;
+                break;
+            case SlotState::Running:
+                if (now >= slot.started + slot.deadline) {
+                    slot.state    = SlotState::Abandoned;
+                    slot.finished = now;
+                    stats.timedOut = true;
+                    settled[i] = true;
+                    --remaining;
+                    logRecord(LogLevel::Warning, LogSource::Probe, "Probe timed out.",
+                              {{"probe", slot.name}, {"deadline_ms", std::to_string(slot.deadline.count())}});
+                    if (hasPending(*shared)) spawnWorker(shared);
+                    shared->cv.notify_all();    // dependents of this task may run now
+                } else {
+                    wakeAt = std::min(wakeAt, slot.started + slot.deadline);
+                }
+                break;
+            default:
+                break;
+            }
+
+            if (remaining != before) progressed = true;
+            if (remaining != before && onSettled) {
+                stats.wallMs = std::chrono::duration<double, std::milli>(slot.finished - slot.started).count();
+                stats.spawns = slot.spawns;
+                stats.allocations = slot.allocations;
+                lock.unlock();
+                onSettled(i, out, stats);
+                lock.lock();
+                now = Clock::now();
+            }
+        }
+
+        if (remaining == 0) break;
+        // onSettled ran unlocked, so an earlier slot may have settled (and
+        // notified) meanwhile; rescan before sleeping.
+        if (progressed) continue;
+        if (wakeAt == Clock::time_point::max()) shared->cv.wait(lock);
+        else                                    shared->cv.wait_until(lock, wakeAt);
+    }
+}
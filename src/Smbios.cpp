@@ -0,0 +1,173 @@
+// ----------------------------------------
+// Smbios.cpp
+// ----------------------------------------
+#include "Smbios.h"
+#include "SysFs.h"
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+
+namespace {
+
+using Bytes = std::vector<unsigned char>;
+
+uint16_t le16(const unsigned char* p) { return uint16_t(p[0] | (p[1] << 8)); }
+uint32_t le32(const unsigned char* p) { return uint32_t(le16(p)) | (uint32_t(le16(p + 2)) << 16); }
+
+// One structure: formatted area plus its trailing string-set.
+struct Structure {
+    uint8_t type;
+    uint8_t length;
+    const unsigned char* data;      // formatted area, `length` bytes
+    const unsigned char* strings;   // first string of the string-set
+    const unsigned char* end;       // one past the double NUL
+
+    bool has(size_t offset, size_t width = 1) const { return offset + width <= length; }
+    uint8_t  byte(size_t off) const { return has(off)    ? data[off]        : 0; }
+    uint16_t word(size_t off) const { return has(off, 2) ? le16(data + off) : 0; }
+    uint32_t dword(size_t off) const { return has(off, 4) ? le32(data + off) : 0; }
+
+    // SMBIOS strings are 1-based indexes into the string-set; 0 = none.
+    std::string str(size_t off) const {
+        uint8_t idx = byte(off);
+        if (idx == 0) return "";
+        const unsigned char* p = strings;
+        while (p < end && *p && --idx) p += std::strlen(reinterpret_cast<const char*>(p)) + 1;
+        if (p >= end || !*p) return "";
+        std::string s(reinterpret_cast<const char*>(p));
+        s.erase(s.find_last_not_of(' ') + 1);
+        return s;
+    }
+};
+
+bool nextStructure(const Bytes& table, size_t& pos, Structure& s) {
+    if (pos + 4 > table.size()) return false;
+    const unsigned char* base = table.data() + pos;
+    s.type   = base[0];
+    s.length = base[1];
+    if (s.length < 4 || pos + s.length > table.size()) return false;
+    s.data    = base;
+    s.strings = base + s.length;
+
+    // String-set ends at the first double NUL.
+    const unsigned char* p   = s.strings;
+    const unsigned char* lim = table.data() + table.size();
+    while (p + 1 < lim && !(p[0] == 0 && p[1] == 0)) ++p;
+    if (p + 1 >= lim) return false;
+    s.end = p + 2;
+    pos = static_cast<size_t>(s.end - table.data());
+    return true;
+}
+
+std::string decodeUuid(const Structure& s, int major, int minor) {
+    if (!s.has(0x08, 16)) return "";
+    const unsigned char* u = s.data + 0x08;
+
+    bool allZero = true, allOnes = true;
+    for (int i = 0; i < 16; ++i) {
+        allZero &= u[i] == 0x00;
+        allOnes &= u[i] == 0xFF;
+    }
+    if (allZero || allOnes) return "";
+
+    // Since 2.6 the first three fields are little-endian.
+    bool le = major > 2 || (major == 2 && minor >= 6);
+    char buf[37];
+    if (le) {
+        std::snprintf(buf, sizeof(buf),
+            "%02x%02x%02x%02x-%02x%02x-%02x%02x-%02x%02x-%02x%02x%02x%02x%02x%02x",
+            u[3], u[2], u[1], u[0], u[5], u[4], u[7], u[6],
+            u[8], u[9], u[10], u[11], u[12], u[13], u[14], u[15]);
+    } else {
+        std::snprintf(buf, sizeof(buf),
+            "%02x%02x%02x%02x-%02x%02x-%02x%02x-%02x%02x-%02x%02x%02x%02x%02x%02x",
+            u[0], u[1], u[2], u[3], u[4], u[5], u[6], u[7],
+            u[8], u[9], u[10], u[11], u[12], u[13], u[14], u[15]);
+    }
+    return buf;
+}
+
+void decodeMemoryDevice(const Structure& s, SmbiosInfo& out) {
+    uint16_t size = s.word(0x0C);
+    if (size == 0 || size == 0xFFFF) return;   // empty slot / unknown
+
+    MemoryModule m;
+    if (size == 0x7FFF)      m.sizeMB = s.dword(0x1C) & 0x7FFFFFFF;   // extended size
+    else if (size & 0x8000)  m.sizeMB = (size & 0x7FFF) / 1024;       // KB granularity
+    else                     m.sizeMB = size;
+
+    m.locator = s.str(0x10);
+    m.type    = smbiosMemoryTypeName(s.byte(0x12));
+
+    uint16_t speed = s.word(0x15);
+    m.speedMTs = speed == 0xFFFF ? s.dword(0x54) : speed;
+
+    out.modules.push_back(std::move(m));
+}
+
+} // namespace
+
+bool readSmbios(SmbiosInfo& out, const std::string& dir) {
+    out = SmbiosInfo{};
+
+    Bytes entry;
+    if (readSysBytes(dir + "/smbios_entry_point", entry, 64)) {
+        if (entry.size() >= 24 && std::memcmp(entry.data(), "_SM3_", 5) == 0) {
+            out.versionMajor = entry[7];
+            out.versionMinor = entry[8];
+        } else if (entry.size() >= 31 && std::memcmp(entry.data(), "_SM_", 4) == 0) {
+            out.versionMajor = entry[6];
+            out.versionMinor = entry[7];
+        }
+    }
+
+    Bytes table;
+    if (!readSysBytes(dir + "/DMI", table)) return false;
+
+    size_t pos = 0;
+    Structure s;
+    while (nextStructure(table, pos, s)) {
+        switch (s.type) {
+        case 1:
+            out.manufacturer   = s.str(0x04);
+            out.productName    = s.str(0x05);
+            out.productVersion = s.str(0x06);
+            out.serial         = s.str(0x07);
+            out.uuid           = decodeUuid(s, out.versionMajor, out.versionMinor);
+            break;
+        case 2:
+            if (out.boardName.empty()) {
+                out.boardVendor = s.str(0x04);
+                out.boardName   = s.str(0x05);
+                out.boardSerial = s.str(0x07);
+            }
+            break;
+        case 3:
+            if (out.chassisType == 0) out.chassisType = s.byte(0x05) & 0x7F;
+            break;
+        case 17:
+            decodeMemoryDevice(s, out);
+            break;
+        case 127:   // end-of-table
+            return true;
+        default:
+            break;
+        }
+    }
+    return true;
+}
+
+bool isPortableChassis(uint8_t t) {
+    return t == 8 || t == 9 || t == 10 || t == 14 || t == 30;
+}
+
+const char* smbiosMemoryTypeName(uint8_t type) {
+    static const char* const names[] = {
+        "",      "",      "",      "DRAM",  "EDRAM", "VRAM",   "SRAM",   "RAM",      // 0x00
+        "ROM",   "Flash", "EEPROM","FEPROM","EPROM", "CDRAM",  "3DRAM",  "SDRAM",    // 0x08
+        "SGRAM", "RDRAM", "DDR",   "DDR2",  "DDR2 FB-DIMM", "", "",      "",         // 0x10
+        "DDR3",  "FBD2",  "DDR4",  "LPDDR", "LPDDR2","LPDDR3", "LPDDR4", "Logical non-volatile device", // 0x18
+        "HBM",   "HBM2",  "DDR5",  "LPDDR5","HBM3",                                   // 0x20
+    };
+    return type < std::size(names) ? names[type] : "";
+}
@@ -0,0 +1,200 @@
+// ----------------------------------------
+// SysFs.cpp
+// ----------------------------------------
+#include "SysFs.h"
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+std::string gSysRoot;
+std::string gRecordDir;
+}
+
+void setSysRoot(std::string root) {
+    while (root.size() > 1 && root.back() == '/') root.pop_back();
+    gSysRoot = root == "/" ? std::string() : std::move(root);
+}
+
+const std::string& sysRoot() {
+    return gSysRoot;
+}
+
+std::string sysPath(const std::string& path) {
+    return gSysRoot.empty() ? path : gSysRoot + path;
+}
+
+std::string commandFixtureName(std::string_view cmd) {
+    // FNV-1a: stable across builds and platforms, unlike std::hash.
+    uint64_t h = 1469598103934665603ULL;
+    for (unsigned char c : cmd) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    char name[17];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(h));
+    return name;
+}
+
+bool readCommandFixture(std::string_view cmd, std::string& out) {
+    std::vector<unsigned char> bytes;
+    if (!readSysBytes("/commands/" + commandFixtureName(cmd), bytes)) return false;
+    out.assign(bytes.begin(), bytes.end());
+    return true;
+}
+
+void setCommandRecordDir(std::string dir) {
+    gRecordDir = std::move(dir);
+}
+
+void recordCommandFixture(std::string_view cmd, const std::string& output) {
+    if (gRecordDir.empty()) return;
+    std::string path = gRecordDir + "/" + commandFixtureName(cmd);
+    if (FILE* f = std::fopen(path.c_str(), "w")) {
+        std::fwrite(output.data(), 1, output.size(), f);
+        std::fclose(f);
+    }
+}
+
+std::string_view readSysFile(const char* path, char* buf, size_t size) {
+    if (size == 0) return {};
+    buf[0] = '\0';
+
+    // The live path stays allocation-free; only fixture runs build a string.
+    int fd = gSysRoot.empty() ? ::open(path, O_RDONLY | O_CLOEXEC)
+                              : ::open((gSysRoot + path).c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return {};
+
+    // sysfs attributes arrive in one read(); procfs files may need a few.
+    size_t total = 0;
+    while (total < size - 1) {
+        ssize_t n = ::read(fd, buf + total, size - 1 - total);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        total += static_cast<size_t>(n);
+    }
+    ::close(fd);
+
+    buf[total] = '\0';
+    return std::string_view(buf, total);
+}
+
+std::string readSysString(const std::string& path) {
+    char buf[256];
+    return std::string(trimView(readSysFile(path, buf)));
+}
+
+bool readSysLong(const std::string& path, long& out) {
+    char buf[64];
+    return parseLong(readSysFile(path, buf), out);
+}
+
+std::vector<std::string> listSysDir(const std::string& path) {
+    std::vector<std::string> names;
+    DIR* dir = ::opendir(sysPath(path).c_str());
+    if (!dir) return names;
+    while (dirent* ent = ::readdir(dir)) {
+        std::string_view name(ent->d_name);
+        if (name == "." || name == "..") continue;
+        names.emplace_back(name);
+    }
+    ::closedir(dir);
+    return names;
+}
+
+bool sysPathExists(const std::string& path) {
+    struct stat st;
+    return ::stat(sysPath(path).c_str(), &st) == 0;
+}
+
+std::string_view trimView(std::string_view s) {
+    const char* ws = " \t\r\n";
+    size_t b = s.find_first_not_of(ws);
+    if (b == std::string_view::npos) return {};
+    size_t e = s.find_last_not_of(ws);
+    return s.substr(b, e - b + 1);
+}
+
+bool startsWith(std::string_view s, std::string_view prefix) {
+    return s.size() >= prefix.size() && s.compare(0, prefix.size(), prefix) == 0;
+}
+
+bool nextLine(std::string_view& text, std::string_view& line) {
+    if (text.empty()) return false;
+    size_t nl = text.find('\n');
+    if (nl == std::string_view::npos) {
+        line = text;
+        text = {};
+    } else {
+        line = text.substr(0, nl);
+        text.remove_prefix(nl + 1);
+    }
+    return true;
+}
+
+std::string_view findField(std::string_view text, std::string_view key, char sep) {
+    std::string_view line;
+    while (nextLine(text, line)) {
+        if (!startsWith(line, key)) continue;
+        std::string_view rest = line.substr(key.size());
+        // "model name\t: ..." in cpuinfo pads the key with tabs/spaces.
+        size_t i = 0;
+        while (i < rest.size() && (rest[i] == ' ' || rest[i] == '\t')) ++i;
+        if (i < rest.size() && rest[i] == sep) return trimView(rest.substr(i + 1));
+    }
+    return {};
+}
+
+bool parseLong(std::string_view s, long& out) {
+    s = trimView(s);
+    bool neg = !s.empty() && s[0] == '-';
+    if (neg) s.remove_prefix(1);
+    if (s.empty() || s[0] < '0' || s[0] > '9') return false;
+    long v = 0;
+    for (char c : s) {
+        if (c < '0' || c > '9') break;
+        v = v * 10 + (c - '0');
+    }
+    out = neg ? -v : v;
+    return true;
+}
+
+bool parseHex(std::string_view s, unsigned long& out) {
+    s = trimView(s);
+    if (startsWith(s, "0x") || startsWith(s, "0X")) s.remove_prefix(2);
+    unsigned long v = 0;
+    size_t n = 0;
+    for (; n < s.size(); ++n) {
+        char c = s[n];
+        int d;
+        if (c >= '0' && c <= '9')      d = c - '0';
+        else if (c >= 'a' && c <= 'f') d = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') d = c - 'A' + 10;
+        else break;
+        v = (v << 4) | static_cast<unsigned long>(d);
+    }
+    if (n == 0) return false;
+    out = v;
+    return true;
+}
+
+bool readSysBytes(const std::string& path, std::vector<unsigned char>& out, size_t maxBytes) {
+    out.clear();
+    int fd = ::open(sysPath(path).c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    unsigned char chunk[4096];
+    while (out.size() < maxBytes) {
+        ssize_t n = ::read(fd, chunk, sizeof(chunk));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        out.insert(out.end(), chunk, chunk + n);
+    }
+    ::close(fd);
+    if (out.size() > maxBytes) out.resize(maxBytes);
+    return !out.empty();
+}
@@ -2,6 +2,17 @@
 // SystemInfo.cpp
 // ----------------------------------------
 #include "SystemInfo.h"
+#include "ProbeScheduler.h"
+#include "ProbeRegistry.h"
+#include "SysFs.h"
+#include "Smbios.h"
+#include "PciBus.h"
+#include "BlockDevices.h"
+#include "PowerSupply.h"
+#include "CpuInfo.h"
+#include "Capabilities.h"
+#include "Trace.h"
+#include <cstdio>
 #include <cstdlib>
 #include <fstream>
 #include <sstream>
@@ -9,20 +20,31 @@
 #include <cmath>
 #include <algorithm>
 #include <unordered_set>
-#include <filesystem>
-#include <Log.h>       // for logMessage(...)
-#include <regex>
+#include <set>
+#include <Log.h>       // for logRecord(...)
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <unistd.h>
 
 // Helper: run a shell pipeline and capture stdout (trimmed)
 static std::string runCommand(const char* cmd) {
     std::array<char, 128> buffer;
     std::string result;
+    if (!sysRoot().empty()) {
+        // Fixture run: replay the recorded output, never the real tool.
+        readCommandFixture(cmd, result);
+        result.erase(result.find_last_not_of(" \n\r\t") + 1);
+        return result;
+    }
+    noteProbeSpawn();
     FILE* pipe = popen(cmd, "r");
     if (!pipe) return "";
     while (fgets(buffer.data(), buffer.size(), pipe)) {
         result += buffer.data();
     }
     pclose(pipe);
+    recordCommandFixture(cmd, result);
     // Trim trailing whitespace/newlines:
     if (!result.empty()) {
         result.erase(result.find_last_not_of(" \n\r\t") + 1);
@@ -30,6 +52,23 @@ static std::string runCommand(const char* cmd) {
     return result;
 }
 
+const char* probeStatus(const ProbeTiming& timing) {
+    if (timing.disabled)     return "disabled";
+    if (timing.cached)       return "cached";
+    if (timing.timedOut)     return "timed out";
+    if (timing.failed)       return "failed";
+    if (timing.unprivileged) return "partial";
+    return "ok";
+}
+
+// Replaces the previous result for the same section, if any.
+static void recordTiming(SystemInfo& info, const ProbeTiming& timing) {
+    auto old = std::find_if(info.timings.begin(), info.timings.end(),
+                            [&](const ProbeTiming& t) { return t.section == timing.section; });
+    if (old != info.timings.end()) *old = timing;
+    else                           info.timings.push_back(timing);
+}
+
 bool isAppleOrSurface(const std::string& model) {
     std::string lower = model;
     std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
@@ -38,13 +77,21 @@ bool isAppleOrSurface(const std::string& model) {
         || lower.find("surface") != std::string::npos;
 }
 
-SystemInfo getSystemInfo() {
-    SystemInfo info;
+// ── 1) Determine form factor
+static void probeChassis(ProbeContext& ctx, SystemInfo& info) {
+    const SmbiosInfo* smbios = ctx.smbios();
+    if (smbios && smbios->chassisType != 0) {
+        info.isLaptop = isPortableChassis(smbios->chassisType);
+        return;
+    }
 
-    // We’ll reuse this variable in multiple loops below:
-    std::string line;
+    long type = 0;
+    if (readSysLong("/sys/class/dmi/id/chassis_type", type)) {
+        info.isLaptop = isPortableChassis(static_cast<uint8_t>(type));
+        return;
+    }
 
-    // ── 1) Determine form factor
+    if (!hasCapability(Capability::Dmidecode)) return;
     std::string chassis = runCommand("sudo dmidecode -s chassis-type 2>/dev/null");
     std::string lowerChassis = chassis;
     std::transform(lowerChassis.begin(), lowerChassis.end(), lowerChassis.begin(), ::tolower);
@@ -55,229 +102,452 @@ SystemInfo getSystemInfo() {
     {
         info.isLaptop = true;
     }
+}
 
-    // ── 2) Detect storage‐bus types
+// ── 2) Detect storage‐bus types
+static void probeStorageBuses(ProbeContext& ctx, SystemInfo& info) {
     std::unordered_set<std::string> supported;
     {
-        std::istringstream lspciLines(runCommand(
-            "lspci | grep -iE 'SATA|SAS|NVMe|RAID|IDE|SCSI|AHCI|controller'"
-        ));
-        while (std::getline(lspciLines, line)) {
-            if (line.find("SATA")  != std::string::npos || line.find("AHCI") != std::string::npos)
-                supported.insert("SATA");
-            if (line.find("SAS")   != std::string::npos) supported.insert("SAS");
-            if (line.find("NVMe")  != std::string::npos) supported.insert("NVMe");
-            if (line.find("IDE")   != std::string::npos) supported.insert("IDE");
-            if (line.find("SCSI")  != std::string::npos) supported.insert("SCSI");
-            if (line.find("RAID")  != std::string::npos) supported.insert("RAID");
+        for (const auto& dev : ctx.pci()) {
+            switch (dev.pciClass()) {
+            case PciClassSata: supported.insert("SATA"); break;
+            case PciClassSas:  supported.insert("SAS");  break;
+            case PciClassNvm:  supported.insert("NVMe"); break;
+            case PciClassIde:  supported.insert("IDE");  break;
+            case PciClassScsi: supported.insert("SCSI"); break;
+            case PciClassRaid: supported.insert("RAID"); break;
+            default: break;
+            }
         }
-        if (std::filesystem::exists("/sys/class/nvme")) {
+        if (sysPathExists("/sys/class/nvme")) {
             supported.insert("NVMe");
         }
 
-        std::istringstream lsblkLines(runCommand("lsblk -dno TRAN 2>/dev/null | sort -u"));
-        while (std::getline(lsblkLines, line)) {
-            if (line.find("sata") != std::string::npos) supported.insert("SATA");
-            if (line.find("sas")  != std::string::npos) supported.insert("SAS");
-            if (line.find("nvme") != std::string::npos) supported.insert("NVMe");
-            if (line.find("usb")  != std::string::npos) supported.insert("USB");
-            if (line.find("ide")  != std::string::npos) supported.insert("IDE");
-            if (line.find("scsi") != std::string::npos) supported.insert("SCSI");
-            if (line.find("spi")  != std::string::npos) supported.insert("SPI");
+        for (const auto& dev : ctx.blockDevices()) {
+            const std::string& tran = dev.tran;
+            if (tran == "sata")      supported.insert("SATA");
+            else if (tran == "sas")  supported.insert("SAS");
+            else if (tran == "nvme") supported.insert("NVMe");
+            else if (tran == "usb")  supported.insert("USB");
+            else if (tran == "ata")  supported.insert("IDE");
+            else if (tran == "spi")  supported.insert("SPI");
+            else if (tran == "scsi" || tran == "iscsi" || tran == "fc" || tran == "fcoe")
+                supported.insert("SCSI");
         }
     }
     info.storageTypes.assign(supported.begin(), supported.end());
     std::sort(info.storageTypes.begin(), info.storageTypes.end());
+}
 
-    // ── 3) Host Model & Serial
-    info.model  = runCommand("hostnamectl | grep 'Hardware Model' | awk -F': ' '{print $2}'");
-    info.serial = runCommand("sudo dmidecode -s system-serial-number 2>/dev/null");
-    if (info.serial.empty()) info.serial = "Unavailable";
-
-    // ── 4) CPU brand, model, speed, physical sockets
-{
-    std::string modelLine = runCommand("lscpu | awk -F: '/Model name/ {print $2}'");
-    modelLine.erase(0, modelLine.find_first_not_of(" \t\n\r"));
-    info.cpuModel = "Unknown";
-    info.cpuBrand = "Unknown";
-    info.cpuSpeed = "Unknown";
-
-    if (!modelLine.empty()) {
-        // 1. Extract speed
-        std::smatch speedMatch;
-        std::regex speedRegex(R"(@\s*([0-9.]+)GHz)");
-        if (std::regex_search(modelLine, speedMatch, speedRegex)) {
-            info.cpuSpeed = speedMatch[1].str(); // "2.90"
-            modelLine = modelLine.substr(0, speedMatch.position());
-            modelLine.erase(modelLine.find_last_not_of(" \t\n\r") + 1);
-        }
-
-        // 2. Extract model number (e.g., 10700, 5800X)
-        std::smatch modelMatch;
-        std::regex modelRegex(R"((\d{4,5}[A-Za-z]{0,2}))");
-        if (std::regex_search(modelLine, modelMatch, modelRegex)) {
-            std::string fullModel = modelMatch[1].str();  // e.g., "i7-10700"
-            size_t dash = fullModel.find('-');
-            if (dash != std::string::npos && dash + 1 < fullModel.size()) {
-                info.cpuModel = fullModel.substr(dash + 1); // keeps only "10700"
-            } else {
-                info.cpuModel = fullModel;
-            }
+// ── 3) Host Model & Serial
+static void probeIdentity(ProbeContext& ctx, SystemInfo& info) {
+    // Same source hostnamectl's "Hardware Model" uses; Lenovo keeps the
+    // marketing name in product_version and a part number in product_name.
+    std::string vendor = readSysString("/sys/class/dmi/id/sys_vendor");
+    if (startsWith(vendor, "LENOVO"))
+        info.model = readSysString("/sys/class/dmi/id/product_version");
+    if (info.model.empty())
+        info.model = readSysString("/sys/class/dmi/id/product_name");
+    if (info.model.empty()) {
+        char buf[256];
+        std::string_view dt = readSysFile("/proc/device-tree/model", buf);
+        info.model = std::string(trimView(dt.substr(0, dt.find('\0'))));
+    }
 
-            // 3. Extract brand by trimming before model
-            if (modelMatch.position() > 0) {
-                std::string brand = modelLine.substr(0, modelMatch.position());
+    const SmbiosInfo* smbios = ctx.smbios();
+    if (smbios) {
+        info.serial = smbios->serial;
+        info.board  = smbios->boardVendor + " " + smbios->boardName;
+    } else {
+        info.serial = readSysString("/sys/class/dmi/id/product_serial");   // root-only
+        info.board  = readSysString("/sys/class/dmi/id/board_vendor") + " " +
+                      readSysString("/sys/class/dmi/id/board_name");
+    }
+    info.board = std::string(trimView(info.board));
+    if (info.serial.empty() && hasCapability(Capability::Dmidecode))
+        info.serial = runCommand("sudo dmidecode -s system-serial-number 2>/dev/null");
+    if (info.serial.empty()) info.serial = "Unavailable";
+}
 
-                // Cleanup: remove (R), (TM), "CPU", "Processor", etc.
-                brand = std::regex_replace(brand, std::regex(R"(\(.*?\)|CPU|Processor)", std::regex::icase), "");
-                brand.erase(std::unique(brand.begin(), brand.end(),
-                    [](char a, char b) { return std::isspace(a) && std::isspace(b); }), brand.end());
-                brand.erase(brand.find_last_not_of(" \t\n\r") + 1);
+// ── 4) CPU brand, model, speed, physical sockets
+static void probeCpu(SystemInfo& info) {
+    CpuName cpu = parseCpuName(readCpuBrandString());
+    info.cpuBrand = cpu.brand;
+    info.cpuModel = cpu.model;
+    info.cpuSpeed = cpu.speed;
 
-                if (!brand.empty() && brand.back() == '-') {
-                    brand.pop_back();
-                }
+    // 4. Socket count: distinct physical package ids across cpus
+    std::unordered_set<long> packages;
+    for (const auto& name : listSysDir("/sys/devices/system/cpu")) {
+        if (name.size() < 4 || !startsWith(name, "cpu") || name[3] < '0' || name[3] > '9') continue;
+        long id = 0;
+        if (readSysLong("/sys/devices/system/cpu/" + name + "/topology/physical_package_id", id))
+            packages.insert(id);
+    }
+    info.physicalCPUs = packages.empty() ? "Unknown" : std::to_string(packages.size());
+}
 
-                info.cpuBrand = brand;
+// ── 5) GPU Info
+static void probeGpu(ProbeContext& ctx, SystemInfo& info) {
+    // First VGA-class function from sysfs + pci.ids; screenfetch only when
+    // there's no PCI display controller to name (e.g. SoC graphics).
+    if (hasCapability(Capability::PciSysfs)) {
+        for (const auto& dev : ctx.pci()) {
+            if (dev.pciClass() == PciClassVga) {
+                info.gpu = dev.displayName();
+                return;
             }
-        } else {
-            info.cpuModel = modelLine;
-            info.cpuBrand = "Unknown";
         }
     }
-
-    // 4. Socket count
-    std::string sockets = runCommand("lscpu | grep 'Socket(s):' | awk '{print $2}'");
-    sockets.erase(sockets.find_last_not_of(" \n\r\t") + 1);
-    info.physicalCPUs = sockets.empty() ? "Unknown" : sockets;
+    if (hasCapability(Capability::Screenfetch))
+        info.gpu = runCommand("screenfetch -nN | grep 'GPU:' | head -n1 | awk -F': ' '{print $2}'");
 }
 
-    // ── 5) GPU Info
-    info.gpu = runCommand("screenfetch -nN | grep 'GPU:' | head -n1 | awk -F': ' '{print $2}'");
-    if (info.gpu.empty()) {
-        // fallback if screenfetch not installed
-        info.gpu = runCommand("lspci | grep -i 'VGA' | head -n1 | awk -F': ' '{print $3}'");
+// ── 6) RAM Info (rounded to nearest even >8GB, or nearest int ≤8GB)
+static void probeMemory(ProbeContext& ctx, SystemInfo& info) {
+    char meminfo[2048];
+    long memKb = 0;
+    parseLong(findField(readSysFile("/proc/meminfo", meminfo), "MemTotal"), memKb);
+    int memGb = 0;
+    if (memKb > 0) {
+        double rawGb = memKb / 1048576.0;
+        if (rawGb > 8.0) {
+            int half = static_cast<int>(std::ceil(rawGb / 2.0));
+            memGb = half * 2;
+        } else {
+            memGb = static_cast<int>(std::round(rawGb));
+        }
     }
+    info.ram = std::to_string(memGb) + " GB";
 
-    // ── 6) RAM Info (rounded to nearest even >8GB, or nearest int ≤8GB)
-    {
-        std::string memKbStr = runCommand("grep MemTotal /proc/meminfo | awk '{print $2}'");
-        long memKb = memKbStr.empty() ? 0 : std::stol(memKbStr);
-        int memGb = 0;
-        if (memKb > 0) {
-            double rawGb = memKb / 1048576.0;
-            if (rawGb > 8.0) {
-                int half = static_cast<int>(std::ceil(rawGb / 2.0));
-                memGb = half * 2;
-            } else {
-                memGb = static_cast<int>(std::round(rawGb));
-            }
+    // 6b) memoryType + per-DIMM details from SMBIOS type 17
+    if (const SmbiosInfo* smbios = ctx.smbios()) {
+        info.memoryModules = smbios->modules;
+        std::vector<std::string> types;
+        for (const auto& m : smbios->modules) {
+            if (!m.type.empty() && std::find(types.begin(), types.end(), m.type) == types.end())
+                types.push_back(m.type);
         }
-        info.ram = std::to_string(memGb) + " GB";
-
-        // 6b) memoryType via dmidecode
-        std::string memType = runCommand(
+        std::sort(types.begin(), types.end());
+        for (const auto& t : types) {
+            if (!info.memoryType.empty()) info.memoryType += "/";
+            info.memoryType += t;
+        }
+    } else if (hasCapability(Capability::Dmidecode)) {
+        info.memoryType = runCommand(
             "sudo dmidecode -t memory | grep 'Type:' | grep -v 'Unknown\\|Error' | sort | uniq | awk '{print $2}'"
         );
-        memType.erase(memType.find_last_not_of(" \n\r\t") + 1);
-        info.memoryType = memType.empty() ? "Unknown" : memType;
+        info.memoryType.erase(info.memoryType.find_last_not_of(" \n\r\t") + 1);
+    }
+    if (info.memoryType.empty()) info.memoryType = "Unknown";
+}
+
+// ── 7) Screen resolution + physical size
+static std::string formatDiagonal(double inches) {
+    std::ostringstream oss;
+    oss.precision(1);
+    oss << std::fixed << inches << "\"";
+    return oss.str();
+}
+
+static void probeDisplay(SystemInfo& info) {
+    // Native EDID first: works on KMS-only images with no X server.
+    if (hasCapability(Capability::DrmEdid)) info.displays = enumerateDisplays();
+    if (!info.displays.empty()) {
+        const DisplayOutput& primary = info.displays.front();
+        info.resolution = primary.resolution();
+        double diag = primary.diagonalInches();
+        info.screenSize = diag > 0.0 ? formatDiagonal(diag) : "Unknown";
+        if (info.resolution.empty()) info.resolution = "Unknown";
+        return;
     }
 
-    // ── 7) Screen resolution + physical size
-    info.resolution = runCommand("xdpyinfo | grep dimensions | awk '{print $2}'");
+    // No DRM connector exposed an EDID (e.g. a VM); ask X if it's up.
+    if (hasCapability(Capability::Xdpyinfo))
+        info.resolution = runCommand("xdpyinfo | grep dimensions | awk '{print $2}'");
     if (info.resolution.empty()) {
         info.resolution = "Unknown";
     }
 
-    {
-        std::string edidOutput = runCommand(
+    std::string edidOutput;
+    if (hasCapability(Capability::Xrandr))
+        edidOutput = runCommand(
             "xrandr --verbose | grep -m1 -A5 ' connected' | grep -Eo '[0-9]+mm x [0-9]+mm'"
         );
-        int widthMM = 0, heightMM = 0;
-        if (!edidOutput.empty() &&
-            sscanf(edidOutput.c_str(), "%dmm x %dmm", &widthMM, &heightMM) == 2 &&
-            widthMM > 0 && heightMM > 0)
-        {
-            double wIn = widthMM / 25.4;
-            double hIn = heightMM / 25.4;
-            double diag = std::sqrt(wIn*wIn + hIn*hIn);
-            std::ostringstream oss;
-            oss.precision(1);
-            oss << std::fixed << diag << "\"";
-            info.screenSize = oss.str();
-        } else {
-            info.screenSize = "Unknown";
-        }
+    int widthMM = 0, heightMM = 0;
+    if (!edidOutput.empty() &&
+        sscanf(edidOutput.c_str(), "%dmm x %dmm", &widthMM, &heightMM) == 2 &&
+        widthMM > 0 && heightMM > 0)
+    {
+        double wIn = widthMM / 25.4;
+        double hIn = heightMM / 25.4;
+        info.screenSize = formatDiagonal(std::sqrt(wIn*wIn + hIn*hIn));
+    } else {
+        info.screenSize = "Unknown";
     }
+}
 
-    // ── 8) Battery condition
-    {
-        std::string batteryPath = runCommand("upower -e | grep BAT");
-        if (!batteryPath.empty()) {
-            batteryPath.erase(batteryPath.find_last_not_of(" \n\r\t") + 1);
-            std::string full   = runCommand(
-                ("upower -i " + batteryPath + " | grep 'energy-full:' | awk '{print $2}'").c_str()
-            );
-            std::string design = runCommand(
-                ("upower -i " + batteryPath + " | grep 'energy-full-design:' | awk '{print $2}'").c_str()
-            );
-            if (!full.empty() && !design.empty() && design != "0") {
-                float health = std::stof(full) / std::stof(design) * 100.0f;
-                if (health >= 90.0f)      info.battery = "Excellent";
-                else if (health >= 70.0f) info.battery = "Good";
-                else                      info.battery = "Poor";
-            } else {
-                info.battery = "N/A";
-            }
-        } else {
-            info.battery = "None";
-        }
+// ── 8) Battery condition
+static void probeBattery(SystemInfo& info) {
+    info.batteries = enumerateBatteries();
+    if (info.batteries.empty()) {
+        info.battery = "None";
+        return;
     }
+    info.batteryHealth = combinedBatteryHealth(info.batteries);
+    info.battery = gradeBatteryHealth(info.batteryHealth);
+}
 
-    // ── 9) PCI Devices (filtered)
-    {
-        std::istringstream pciSs(runCommand(
-            "lspci -mm | grep -iv -E 'bridge|host|system peripheral|processing controller|usb|communication|memory controller|cavs' | "
-            "grep -i -E 'VGA|Network|Ethernet|Audio|Non-Volatile' | awk -F'\"' '{print $6}' | sort -u"
-        ));
-        while (std::getline(pciSs, line)) {
-            if (!line.empty()) info.pciDevices.push_back(line);
+// ── 9) PCI Devices (filtered)
+static void probePci(ProbeContext& ctx, SystemInfo& info) {
+    std::set<std::string> names;
+    for (const auto& dev : ctx.pci()) {
+        switch (dev.pciClass()) {
+        case PciClassVga:
+        case PciClassEthernet:
+        case PciClassNetwork:
+        case PciClassAudio:
+        case PciClassHdAudio:
+        case PciClassNvm:
+            break;
+        default:
+            continue;
         }
+        std::string name = dev.deviceName.empty() ? dev.displayName() : dev.deviceName;
+        // Intel cAVS DSPs report as audio but aren't a codec worth listing.
+        std::string lower = name;
+        std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+        if (lower.find("cavs") != std::string::npos) continue;
+        names.insert(name);
     }
+    info.pciDevices.assign(names.begin(), names.end());
+}
 
-    // ── 10) Detected drives (flag non‐USB, log individually)
-    {
-        bool nonUsb = false;
-        std::istringstream driveLines(runCommand(
-            "lsblk -dn -o NAME,TRAN,ROTA,MODEL | awk '$1 !~ /^(loop|sr)/ && $2 != \"\"'"
-        ));
-        while (std::getline(driveLines, line)) {
-            std::istringstream ls(line);
-            std::string name, tran, rota, model;
-            if (!(ls >> name >> tran >> rota)) continue;
-            std::getline(ls, model);
-            model = model.empty() ? "Unknown" : model.substr(model.find_first_not_of(" \t"));
-            std::string type;
-            if (name.rfind("nvme", 0) == 0)    type = "NVMe";
-            else if (rota == "0")             type = "SSD";
-            else if (rota == "1")             type = "HDD";
-            else                               type = "Unknown";
-
-            DriveInfo d{ "/dev/" + name, type, tran, model };
-            info.detectedDrives.push_back(d);
-
-            std::string msg = "[*] Drive detected: " + d.name +
-                              " (Protocol: " + tran +
-                              ", Type: " + type +
-                              ", Model: " + model + ")";
-            logMessage(msg);
-
-            if (tran != "usb") nonUsb = true;
+// ── 10) Detected drives (flag non‐USB, log individually)
+static void probeDrives(ProbeContext& ctx, SystemInfo& info) {
+    bool nonUsb = false;
+    for (const auto& dev : ctx.blockDevices()) {
+        if (dev.tran.empty()) continue;     // dm, md, nbd: not a physical bus
+
+        std::string type;
+        if (startsWith(dev.name, "nvme")) type = "NVMe";
+        else if (dev.rotational)          type = "HDD";
+        else                              type = "SSD";
+        std::string model = dev.model.empty() ? "Unknown" : dev.model;
+
+        DriveInfo d{ "/dev/" + dev.name, type, dev.tran, model, dev.sizeBytes };
+        info.detectedDrives.push_back(d);
+
+        logRecord(LogLevel::Info, LogSource::Probe, "Drive detected: " + d.name,
+                  {{"protocol", d.tran}, {"type", type}, {"model", model}});
+
+        if (d.tran != "usb") nonUsb = true;
+    }
+    info.hasNonUsbDrives = nonUsb;
+    if (nonUsb) logRecord(LogLevel::Warning, LogSource::Probe, "One or more non-USB drives detected.");
+    else        logRecord(LogLevel::Success, LogSource::Probe, "No non-USB drives detected.");
+}
+
+const char* probeSectionName(ProbeSection section) {
+    switch (section) {
+    case ProbeSection::Chassis:      return "chassis";
+    case ProbeSection::StorageBuses: return "storage";
+    case ProbeSection::Identity:     return "identity";
+    case ProbeSection::Cpu:          return "cpu";
+    case ProbeSection::Gpu:          return "gpu";
+    case ProbeSection::Memory:       return "memory";
+    case ProbeSection::Display:      return "display";
+    case ProbeSection::Battery:      return "battery";
+    case ProbeSection::Pci:          return "pci";
+    case ProbeSection::Drives:       return "drives";
+    default:                         return "unknown";
+    }
+}
+
+static ProbeDescriptor describeProbe(ProbeSection section, const char* fields,
+                                     ProbeCost cost = ProbeCost::Cheap,
+                                     std::chrono::milliseconds deadline = std::chrono::milliseconds(3000)) {
+    ProbeDescriptor probe;
+    probe.section  = section;
+    probe.fields   = fields;
+    probe.cost     = cost;
+    probe.deadline = deadline;
+    return probe;
+}
+
+std::vector<ProbeDescriptor> builtinProbes() {
+    using std::chrono::milliseconds;
+    std::vector<ProbeDescriptor> probes;
+
+    ProbeDescriptor chassis = describeProbe(ProbeSection::Chassis, "isLaptop");
+    chassis.needsRoot = true;   // SMBIOS table; sysfs chassis_type covers most non-root runs
+    chassis.run   = probeChassis;
+    chassis.merge = [](SystemInfo& o, const SystemInfo& p) { o.isLaptop = p.isLaptop; };
+    probes.push_back(chassis);
+
+    ProbeDescriptor storage = describeProbe(ProbeSection::StorageBuses, "storageTypes", ProbeCost::Moderate);
+    storage.run   = probeStorageBuses;
+    storage.merge = [](SystemInfo& o, const SystemInfo& p) { o.storageTypes = p.storageTypes; };
+    probes.push_back(storage);
+
+    ProbeDescriptor identity = describeProbe(ProbeSection::Identity, "model, serial, board");
+    identity.needsRoot = true;  // product_serial is root-only
+    identity.critical  = true;  // the drive gate exempts Apple/Surface by model
+    identity.run   = probeIdentity;
+    identity.merge = [](SystemInfo& o, const SystemInfo& p) { o.model = p.model; o.serial = p.serial; o.board = p.board; };
+    probes.push_back(identity);
+
+    ProbeDescriptor cpu = describeProbe(ProbeSection::Cpu, "cpuBrand, cpuModel, cpuSpeed, physicalCPUs");
+    cpu.run   = [](ProbeContext&, SystemInfo& p) { probeCpu(p); };
+    cpu.merge = [](SystemInfo& o, const SystemInfo& p) {
+        o.cpuBrand     = p.cpuBrand;
+        o.cpuModel     = p.cpuModel;
+        o.cpuSpeed     = p.cpuSpeed;
+        o.physicalCPUs = p.physicalCPUs;
+    };
+    probes.push_back(cpu);
+
+    ProbeDescriptor gpu = describeProbe(ProbeSection::Gpu, "gpu", ProbeCost::Expensive, milliseconds(5000));
+    gpu.run   = probeGpu;
+    gpu.merge = [](SystemInfo& o, const SystemInfo& p) { o.gpu = p.gpu; };
+    probes.push_back(gpu);
+
+    ProbeDescriptor memory = describeProbe(ProbeSection::Memory, "ram, memoryType, memoryModules");
+    memory.needsRoot = true;    // DIMM types come from the SMBIOS table
+    memory.run   = probeMemory;
+    memory.merge = [](SystemInfo& o, const SystemInfo& p) {
+        o.ram           = p.ram;
+        o.memoryType    = p.memoryType;
+        o.memoryModules = p.memoryModules;
+    };
+    probes.push_back(memory);
+
+    ProbeDescriptor display = describeProbe(ProbeSection::Display, "resolution, screenSize, displays",
+                                            ProbeCost::Moderate, milliseconds(2000));
+    display.run   = [](ProbeContext&, SystemInfo& p) { probeDisplay(p); };
+    display.merge = [](SystemInfo& o, const SystemInfo& p) {
+        o.resolution = p.resolution;
+        o.screenSize = p.screenSize;
+        o.displays   = p.displays;
+    };
+    probes.push_back(display);
+
+    ProbeDescriptor battery = describeProbe(ProbeSection::Battery, "battery, batteryHealth, batteries");
+    battery.run   = [](ProbeContext&, SystemInfo& p) { probeBattery(p); };
+    battery.merge = [](SystemInfo& o, const SystemInfo& p) {
+        o.battery       = p.battery;
+        o.batteryHealth = p.batteryHealth;
+        o.batteries     = p.batteries;
+    };
+    probes.push_back(battery);
+
+    ProbeDescriptor pci = describeProbe(ProbeSection::Pci, "pciDevices", ProbeCost::Moderate);
+    pci.run   = probePci;
+    pci.merge = [](SystemInfo& o, const SystemInfo& p) { o.pciDevices = p.pciDevices; };
+    probes.push_back(pci);
+
+    ProbeDescriptor drives = describeProbe(ProbeSection::Drives, "detectedDrives, hasNonUsbDrives",
+                                           ProbeCost::Moderate, milliseconds(5000));
+    drives.critical = true;     // gates the UI until wiped
+    drives.run   = probeDrives;
+    drives.merge = [](SystemInfo& o, const SystemInfo& p) {
+        o.detectedDrives  = p.detectedDrives;
+        o.hasNonUsbDrives = p.hasNonUsbDrives;
+    };
+    probes.push_back(drives);
+
+    return probes;
+}
+
+void refreshSystemInfo(SystemInfo& info, ProbeMask sections, const ProbeCallback& onSection) {
+    auto ctx = std::make_shared<ProbeContext>();
+
+    ProbeMask disabled = sections & disabledProbes();
+    for (unsigned s = 0; s < static_cast<unsigned>(ProbeSection::Count); ++s) {
+        ProbeSection section = static_cast<ProbeSection>(s);
+        if (!(disabled & probeBit(section))) continue;
+        ProbeTiming timing;
+        timing.section  = probeSectionName(section);
+        timing.disabled = true;
+        recordTiming(info, timing);
+        if (onSection) onSection(section, info);    // settled: keeps its defaults
+    }
+
+    bool root = geteuid() == 0;
+    ProbeScheduler scheduler;
+    std::vector<const ProbeDescriptor*> added = probeRunOrder(sections & ~disabled);
+    for (size_t i = 0; i < added.size(); ++i) {
+        const ProbeDescriptor* probe = added[i];
+        std::vector<size_t> after;
+        for (size_t j = 0; j < i; ++j) {
+            if (probe->dependsOn & probeBit(added[j]->section)) after.push_back(j);
         }
-        info.hasNonUsbDrives = nonUsb;
-        if (nonUsb) logMessage("[-] Warning: One or more non-USB drives detected.");
-        else        logMessage("[+] No non-USB drives detected.");
+
+        const char* name = probeSectionName(probe->section);
+        scheduler.add(name, probe->deadline, [name, ctx, run = probe->run](SystemInfo& p) {
+            TraceScope trace(name, "probe");
+            run(*ctx, p);
+        }, probe->merge, std::move(after));
     }
 
+    scheduler.run(info, [&](size_t index, const SystemInfo&, const ProbeScheduler::TaskStats& stats) {
+        const ProbeDescriptor* probe = added[index];
+        ProbeSection section = probe->section;
+        ProbeTiming timing;
+        timing.section     = probeSectionName(section);
+        timing.wallMs      = stats.wallMs;
+        timing.spawns      = stats.spawns;
+        timing.allocations = stats.allocations;
+        timing.timedOut    = stats.timedOut;
+        timing.failed      = stats.failed;
+        timing.unprivileged = probe->needsRoot && !root;
+        recordTiming(info, timing);
+
+        char wallMs[32];
+        std::snprintf(wallMs, sizeof(wallMs), "%.1f", stats.wallMs);
+        logRecord(LogLevel::Info, LogSource::Probe, std::string("Probe ") + probeSectionName(section) + " settled.",
+                  {{"status", probeStatus(timing)}, {"wall_ms", wallMs}, {"spawns", std::to_string(stats.spawns)}});
+
+        if (onSection) onSection(section, info);
+    });
+}
+
+SystemInfo defaultSystemInfo() {
+    // Defaults for any probe that fails or misses its deadline. The drive
+    // gate fails safe: if we could not look, assume internal drives exist.
+    SystemInfo info;
+    info.model           = "Unknown";
+    info.serial          = "Unavailable";
+    info.cpuBrand        = "Unknown";
+    info.cpuModel        = "Unknown";
+    info.cpuSpeed        = "Unknown";
+    info.physicalCPUs    = "Unknown";
+    info.gpu             = "Unknown";
+    info.ram             = "Unknown";
+    info.memoryType      = "Unknown";
+    info.resolution      = "Unknown";
+    info.screenSize      = "Unknown";
+    info.battery         = "N/A";
+    info.hasNonUsbDrives = true;
     return info;
 }
+
+SystemInfo getSystemInfo(const ProbeCallback& onSection) {
+    SystemInfo info = defaultSystemInfo();
+    refreshSystemInfo(info, kAllProbeSections, onSection);
+    return info;
+}
+
+ProbeMask probeSectionsUsingPackages(const std::vector<std::string>& packages) {
+    // Mirrors the tool capabilities checked in the probes above.
+    ProbeMask mask = 0;
+    for (const auto& pkg : packages) {
+        if (pkg == "dmidecode")
+            mask |= probeBit(ProbeSection::Chassis) | probeBit(ProbeSection::Identity) | probeBit(ProbeSection::Memory);
+        else if (pkg == "screenfetch")
+            mask |= probeBit(ProbeSection::Gpu);
+        else if (pkg == "x11-utils" || pkg == "x11-xserver-utils")
+            mask |= probeBit(ProbeSection::Display);
+    }
+    return mask;
+}
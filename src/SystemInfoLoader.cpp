@@ -0,0 +1,120 @@
+// ----------------------------------------
+// SystemInfoLoader.cpp
+// ----------------------------------------
+#include "SystemInfoLoader.h"
+#include "ProbeCache.h"
+#include "Log.h"
+#include "Trace.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+struct SystemInfoLoader::State {
+    std::mutex runMutex;    // one probe pass at a time, so passes can't interleave fields
+    std::mutex m;
+    SystemInfo latest;
+    ProbeMask readyMask = 0;
+    ProbeMask unverified = 0;   // shown from the cache, not yet re-probed
+    std::atomic<uint64_t> version{0};
+    std::string cacheKey;   // set by the first pass, before any refresh runs
+    DisplayOutput cachedPanel;  // likewise; connector "" if none was cached
+
+    void publish(const SystemInfo& snapshot, ProbeMask ready) {
+        std::lock_guard<std::mutex> lock(m);
+        latest = snapshot;
+        readyMask |= ready;
+        unverified &= ~ready;
+        version.fetch_add(1, std::memory_order_release);
+    }
+};
+
+SystemInfoLoader::SystemInfoLoader() : state(std::make_shared<State>()) {}
+
+void SystemInfoLoader::start() {
+    // Detached: the probe thread owns a reference to the state, and every
+    // probe has a deadline, so it always winds down on its own.
+    std::thread([st = state] {
+        std::lock_guard<std::mutex> run(st->runMutex);
+        traceBegin("probe cache", "probe");
+        st->cacheKey = machineCacheKey();
+
+        // A cache hit shows the static sections at once; everything else
+        // (drives, RAM, battery, identity, ...) is still probed live.
+        SystemInfo info = defaultSystemInfo();
+        ProbeMask cached = 0;
+        if (loadProbeCache(st->cacheKey, info, st->cachedPanel)) {
+            cached = kCachedSections;
+            for (unsigned s = 0; s < static_cast<unsigned>(ProbeSection::Count); ++s) {
+                ProbeSection section = static_cast<ProbeSection>(s);
+                if (!(cached & probeBit(section))) continue;
+                ProbeTiming timing;
+                timing.section = probeSectionName(section);
+                timing.cached  = true;
+                info.timings.push_back(timing);
+            }
+            logRecord(LogLevel::Success, LogSource::Cache, "Loaded cached probe results for this machine.");
+            st->publish(info, cached);
+            std::lock_guard<std::mutex> lock(st->m);
+            st->unverified = cached;
+        }
+        traceEnd("probe cache", "probe");
+
+        auto landed = [&](ProbeSection section, const SystemInfo&) {
+            if (section == ProbeSection::Display) applyCachedPanel(info, st->cachedPanel);
+            st->publish(info, probeBit(section));
+        };
+        refreshSystemInfo(info, kAllProbeSections & ~cached, landed);
+
+        // The cached sections stay on screen while they are re-probed live,
+        // after the rest so they don't compete with it. A section that
+        // fails or times out now keeps its cached value.
+        if (cached) {
+            SystemInfo before = info;
+            refreshSystemInfo(info, cached, landed);
+            if (!sameCachedFields(before, info))
+                logRecord(LogLevel::Warning, LogSource::Cache, "Hardware changed since it was cached; using live results.");
+        }
+        saveProbeCache(st->cacheKey, info);
+        st->publish(info, kAllProbeSections);
+    }).detach();
+}
+
+void SystemInfoLoader::refresh(ProbeMask sections) {
+    if (!sections) return;
+    std::thread([st = state, sections] {
+        // Waits out a pass still in flight, then starts from its result.
+        std::lock_guard<std::mutex> run(st->runMutex);
+        SystemInfo info;
+        {
+            std::lock_guard<std::mutex> lock(st->m);
+            st->readyMask &= ~sections;
+            st->version.fetch_add(1, std::memory_order_release);
+            info = st->latest;
+        }
+        refreshSystemInfo(info, sections, [&](ProbeSection section, const SystemInfo&) {
+            if (section == ProbeSection::Display) applyCachedPanel(info, st->cachedPanel);
+            st->publish(info, probeBit(section));
+        });
+        saveProbeCache(st->cacheKey, info);
+        st->publish(info, sections);
+    }).detach();
+}
+
+bool SystemInfoLoader::poll(SystemInfo& out) {
+    if (state->version.load(std::memory_order_acquire) == seenVersion) return false;
+
+    std::lock_guard<std::mutex> lock(state->m);
+    out = state->latest;
+    readyMask = state->readyMask;
+    unverified = state->unverified;
+    seenVersion = state->version.load(std::memory_order_relaxed);
+    return true;
+}
+
+bool SystemInfoLoader::isReady(ProbeSection section) const {
+    return readyMask & probeBit(section);
+}
+
+bool SystemInfoLoader::isComplete() const {
+    return readyMask == kAllProbeSections && !unverified;
+}
@@ -0,0 +1,100 @@
+// ----------------------------------------
+// Trace.cpp
+// ----------------------------------------
+#include "Trace.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Event {
+    const char* name;
+    const char* category;
+    char phase;             // 'B', 'E' or 'i'
+    long tid;
+    long long ns;           // since traceEnable()
+};
+
+std::atomic<bool> gEnabled{false};
+Clock::time_point gStart;
+std::mutex gMutex;
+std::vector<Event> gEvents;
+
+// Startup needs a few hundred events; the cap only matters when the trace
+// is never written (the snapshot never completes) and background checks
+// keep recording for the whole session.
+constexpr size_t kMaxEvents = 1 << 16;
+
+long currentTid() {
+    thread_local long tid = static_cast<long>(::syscall(SYS_gettid));
+    return tid;
+}
+
+void record(const char* name, const char* category, char phase) {
+    if (!gEnabled.load(std::memory_order_relaxed)) return;
+    long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - gStart).count();
+    long tid = currentTid();
+    std::lock_guard<std::mutex> lock(gMutex);
+    if (gEvents.size() < kMaxEvents) gEvents.push_back({ name, category, phase, tid, ns });
+}
+
+} // namespace
+
+void traceEnable() {
+    std::lock_guard<std::mutex> lock(gMutex);
+    if (gEnabled.load()) return;
+    gEvents.reserve(1024);
+    gStart = Clock::now();
+    gEnabled.store(true, std::memory_order_release);
+}
+
+bool traceEnabled() {
+    return gEnabled.load(std::memory_order_relaxed);
+}
+
+void traceBegin(const char* name, const char* category) {
+    record(name, category, 'B');
+}
+
+void traceEnd(const char* name, const char* category) {
+    record(name, category, 'E');
+}
+
+void traceInstant(const char* name, const char* category) {
+    record(name, category, 'i');
+}
+
+bool writeTrace(const std::string& path) {
+    // The trace covers startup only: stop recording and hand the buffer
+    // over, so later connectivity checks and installs add nothing.
+    std::vector<Event> events;
+    {
+        std::lock_guard<std::mutex> lock(gMutex);
+        gEnabled.store(false, std::memory_order_relaxed);
+        events.swap(gEvents);
+    }
+
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) return false;
+
+    // Names are literals from our own code, so no JSON escaping is needed.
+    long pid = static_cast<long>(::getpid());
+    std::fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    std::fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%ld,\"tid\":%ld,\"args\":{\"name\":\"debXray\"}}",
+                 pid, pid);
+    for (const auto& e : events) {
+        // ts is in microseconds; keep the nanoseconds as the fraction.
+        std::fprintf(f, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\",\"pid\":%ld,\"tid\":%ld,\"ts\":%lld.%03lld%s}",
+                     e.name, e.category, e.phase, pid, e.tid, e.ns / 1000, e.ns % 1000,
+                     e.phase == 'i' ? ",\"s\":\"p\"" : "");
+    }
+    std::fprintf(f, "\n]}\n");
+    return std::fclose(f) == 0;
+}
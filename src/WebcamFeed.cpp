@@ -1,39 +1,92 @@
 #include "WebcamFeed.h"
 #include "Log.h"
+#include "SysFs.h"
+#include "Trace.h"
 #include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <linux/videodev2.h>
+
+namespace {
+
+// /dev/videoN nodes that can actually capture video, in index order.
+// Many laptops expose a metadata node next to each camera, and no camera
+// at all means no nodes; either way nothing here blocks for long.
+std::vector<int> findCaptureDevices() {
+    std::vector<int> indices;
+    for (const auto& name : listSysDir("/sys/class/video4linux")) {
+        long index = 0;
+        if (!startsWith(name, "video") || !parseLong(std::string_view(name).substr(5), index)) continue;
+
+        std::string dev = "/dev/" + name;
+        int fd = ::open(dev.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+        if (fd < 0) continue;
+        v4l2_capability cap{};
+        bool ok = ::ioctl(fd, VIDIOC_QUERYCAP, &cap) == 0;
+        ::close(fd);
+        if (!ok) continue;
+
+        uint32_t caps = (cap.capabilities & V4L2_CAP_DEVICE_CAPS) ? cap.device_caps : cap.capabilities;
+        if ((caps & V4L2_CAP_VIDEO_CAPTURE) && (caps & V4L2_CAP_STREAMING))
+            indices.push_back(static_cast<int>(index));
+    }
+    std::sort(indices.begin(), indices.end());
+    return indices;
+}
+
+enum class CamState { Searching, Ready, Failed };
+
+} // namespace
 
 class WebcamFeed::Impl {
 public:
     Impl(SDL_Renderer* renderer)
-    : renderer(renderer), texture(nullptr), failed(true) {
-        for (int i = 0; i < 5; ++i) {
-            cap.open(i);
-            if (cap.isOpened()) {
-                logMessage("[+] Webcam opened: /dev/video" + std::to_string(i));
-                cap.set(cv::CAP_PROP_FRAME_WIDTH, 320);
-                cap.set(cv::CAP_PROP_FRAME_HEIGHT, 240);
-                failed = false;
-                break;
+    : state(std::make_shared<State>()), renderer(renderer), texture(nullptr) {
+        // Detached: a driver that hangs in open() must never hold up exit.
+        // The finder owns a reference to the state, and the capture is only
+        // touched by the UI thread once `status` says Ready, so the handoff
+        // needs no lock.
+        std::thread([st = state] {
+            TraceScope trace("webcam discovery", "webcam");
+            for (int i : findCaptureDevices()) {
+                if (st->stop.load(std::memory_order_acquire)) return;
+                st->cap.open(i, cv::CAP_V4L2);
+                if (st->cap.isOpened()) {
+                    if (st->stop.load(std::memory_order_acquire)) {
+                        st->cap.release();
+                        return;
+                    }
+                    logRecord(LogLevel::Success, LogSource::Webcam, "Webcam opened: /dev/video" + std::to_string(i));
+                    st->cap.set(cv::CAP_PROP_FRAME_WIDTH, 320);
+                    st->cap.set(cv::CAP_PROP_FRAME_HEIGHT, 240);
+                    st->status.store(CamState::Ready, std::memory_order_release);
+                    return;
+                }
             }
-        }
-
-        if (failed) {
-            logMessage("[-] Failed to open any webcam.");
-        }
+            logRecord(LogLevel::Warning, LogSource::Webcam, "Failed to open any webcam.");
+            st->status.store(CamState::Failed, std::memory_order_release);
+        }).detach();
     }
 
 
     ~Impl() {
+        state->stop.store(true, std::memory_order_release);
         if (texture) SDL_DestroyTexture(texture);
     }
 
     void update() {
-        if (failed) return;
+        if (state->status.load(std::memory_order_acquire) != CamState::Ready) return;
 
         cv::Mat frame;
-        if (!cap.read(frame)) {
-            logMessage("[-] Webcam capture failed — no frame returned.");
-            failed = true;
+        if (!state->cap.read(frame)) {
+            logRecord(LogLevel::Error, LogSource::Webcam, "Webcam capture failed — no frame returned.");
+            state->status.store(CamState::Failed, std::memory_order_relaxed);
             return;
         }
 
@@ -52,19 +105,28 @@ public:
     }
 
     SDL_Texture* getTexture() const {
-        return failed ? nullptr : texture;
+        return state->status.load(std::memory_order_acquire) == CamState::Ready ? texture : nullptr;
+    }
+
+    bool isSearching() const {
+        return state->status.load(std::memory_order_acquire) == CamState::Searching;
     }
 
     bool isFailed() const {
-        return failed;
+        return state->status.load(std::memory_order_acquire) == CamState::Failed;
     }
 
 private:
+    struct State {
+        cv::VideoCapture cap;
+        std::atomic<CamState> status{CamState::Searching};
+        std::atomic<bool> stop{false};
+    };
+
+    std::shared_ptr<State> state;   // shared with the finder thread
     SDL_Renderer* renderer;
-    cv::VideoCapture cap;
     SDL_Texture* texture;
     int lastWidth = 0, lastHeight = 0;
-    bool failed;
 };
 
 
@@ -72,4 +134,5 @@ WebcamFeed::WebcamFeed(SDL_Renderer* r) : impl(new Impl(r)) {}
 WebcamFeed::~WebcamFeed() { delete impl; }
 void WebcamFeed::update() { impl->update(); }
 SDL_Texture* WebcamFeed::getTexture() const { return impl->getTexture(); }
-bool WebcamFeed::isFailed() const { return impl->isFailed(); }
\ No newline at end of file
+bool WebcamFeed::isSearching() const { return impl->isSearching(); }
+bool WebcamFeed::isFailed() const { return impl->isFailed(); }
@@ -1,6 +1,10 @@
 // debXray main.cpp (fully updated)
 
 #include "SystemInfo.h"
+#include "SystemInfoLoader.h"
+#include "Connectivity.h"
+#include "Capabilities.h"
+#include "Trace.h"
 #include "DependencyManager.h"
 #include "Renderer.h"
 #include "Log.h"
@@ -15,13 +19,30 @@
 #include <unordered_set>
 #include <string>
 #include <array>
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 #include <curl/curl.h>
 
 using json = nlohmann::json;
 static std::unordered_set<SDL_Scancode> pressedScancodes;
 
+static constexpr char UPLOAD_HOST[] = "cfk-sds.com";
+static ConnectivityMonitor connectivity(UPLOAD_HOST);
+
 json toJson(const SystemInfo &info)
 {
+    json timings = json::array();
+    for (const auto &t : info.timings)
+        timings.push_back({{"section", t.section},
+                           {"status", probeStatus(t)},
+                           {"wall_ms", t.wallMs},
+                           {"spawns", t.spawns},
+                           {"timed_out", t.timedOut},
+                           {"cached", t.cached}});
+
     return {
         {"host_model", info.model},
         {"serial", info.serial},
@@ -49,14 +70,24 @@ json toJson(const SystemInfo &info)
 
         // PCI devices and storage buses
         {"pci_devices", info.pciDevices},
-        {"storage_types", info.storageTypes}};
+        {"storage_types", info.storageTypes},
+
+        // Per-probe cost, so slow fleet hardware shows up in uploads
+        {"diagnostics", {{"probe_timings", timings}}}};
 }
 
 bool uploadSpecs(const json &payload)
 {
-    constexpr char URL[] = "https://cfk-sds.com/api/techline-upload";
+    const std::string URL = "https://" + std::string(UPLOAD_HOST) + "/api/techline-upload";
     constexpr char KEY[] = "secureErase04!";
 
+    if (connectivity.status() == LinkStatus::Offline)
+    {
+        logRecord(LogLevel::Warning, LogSource::Network, "Upload skipped: host unreachable.", {{"host", UPLOAD_HOST}});
+        connectivity.recheck();
+        return false;
+    }
+
     CURL *c = curl_easy_init();
     if (!c)
         return false;
@@ -66,7 +97,7 @@ bool uploadSpecs(const json &payload)
     hdrs = curl_slist_append(
         hdrs, ("X-API-KEY: " + std::string(KEY)).c_str());
 
-    curl_easy_setopt(c, CURLOPT_URL, URL);
+    curl_easy_setopt(c, CURLOPT_URL, URL.c_str());
     curl_easy_setopt(c, CURLOPT_HTTPHEADER, hdrs);
     std::string payloadStr = payload.dump();
     curl_easy_setopt(c, CURLOPT_POSTFIELDS, payloadStr.c_str());
@@ -85,7 +116,7 @@ bool uploadSpecs(const json &payload)
 
     if (rc != CURLE_OK)
     {
-        logMessage("Upload failed: " + std::string(curl_easy_strerror(rc)));
+        logRecord(LogLevel::Error, LogSource::Network, "Upload failed: " + std::string(curl_easy_strerror(rc)));
         return false;
     }
 
@@ -93,11 +124,213 @@ bool uploadSpecs(const json &payload)
     json r = json::parse(resp, nullptr, false);
     std::string status = r.value("status", "error");
     std::string message = r.value("message", "no message");
-    logMessage("[Upload " + status + "]: " + message);
+    logRecord(status == "success" ? LogLevel::Success : LogLevel::Error, LogSource::Network,
+              "Upload " + status + ": " + message);
 
     return status == "success";
 }
 
+// --probe-profile N: run the probes N times and print per-section wall
+// time distributions, without bringing up the UI.
+static int runProbeProfile(int runs)
+{
+    std::map<std::string, std::vector<double>> samples;
+    std::map<std::string, unsigned> spawns;
+    for (int i = 0; i < runs; ++i)
+    {
+        SystemInfo info = getSystemInfo();
+        for (const auto &t : info.timings)
+        {
+            samples[t.section].push_back(t.wallMs);
+            spawns[t.section] = std::max(spawns[t.section], t.spawns);
+        }
+    }
+
+    std::printf("%-10s %10s %10s %10s %7s\n", "section", "min ms", "median ms", "p99 ms", "spawns");
+    for (auto &[section, ms] : samples)
+    {
+        std::sort(ms.begin(), ms.end());
+        size_t p99 = std::min(ms.size() - 1, (ms.size() * 99) / 100);
+        std::printf("%-10s %10.2f %10.2f %10.2f %7u\n",
+                    section.c_str(), ms.front(), ms[ms.size() / 2], ms[p99], spawns[section]);
+    }
+    return 0;
+}
+
+// --json [path]: headless spec sheet for scripted intake. Probes only —
+// no SDL, ImGui, window or camera — then writes the upload document plus
+// the drive list to `path` ("-" for stdout) and exits.
+static int runHeadless(const std::string &path)
+{
+    SystemInfo info = getSystemInfo();
+
+    json doc = toJson(info);
+    json drives = json::array();
+    for (const auto &d : info.detectedDrives)
+        drives.push_back({{"name", d.name},
+                          {"type", d.type},
+                          {"transport", d.tran},
+                          {"model", d.model},
+                          {"size_bytes", d.sizeBytes}});
+    doc["drives"] = drives;
+    doc["is_laptop"] = info.isLaptop;
+
+    std::string text = doc.dump(2) + "\n";
+    if (path == "-")
+    {
+        std::fwrite(text.data(), 1, text.size(), stdout);
+        return std::fflush(stdout) == 0 ? 0 : 1;
+    }
+
+    FILE *f = std::fopen(path.c_str(), "w");
+    if (!f)
+    {
+        std::fprintf(stderr, "debXray: cannot write %s\n", path.c_str());
+        return 1;
+    }
+    bool ok = std::fwrite(text.data(), 1, text.size(), f) == text.size();
+    return (std::fclose(f) == 0 && ok) ? 0 : 1;
+}
+
+static void writeTraceLogged(const std::string &path)
+{
+    if (writeTrace(path))
+        logRecord(LogLevel::Success, LogSource::App, "Trace written.", {{"path", path}});
+    else
+        logRecord(LogLevel::Error, LogSource::App, "Could not write trace.", {{"path", path}});
+}
+
+// Fields whose probe hasn't landed yet render as a dimmed placeholder.
+static bool probing(const SystemInfoLoader &loader, ProbeSection section, const char *label)
+{
+    if (loader.isReady(section))
+        return false;
+    ImGui::TextDisabled("%s: probing...", label);
+    return true;
+}
+
+static void drawSystemInfo(const SystemInfo &info, const SystemInfoLoader &loader)
+{
+    if (!probing(loader, ProbeSection::Chassis, "Form Factor"))
+        ImGui::Text("Form Factor: %s", info.isLaptop ? "Laptop" : "Desktop");
+    if (!probing(loader, ProbeSection::Identity, "Model"))
+    {
+        ImGui::Text("Model: %s", info.model.c_str());
+        ImGui::Text("Serial: %s", info.serial.c_str());
+        if (!info.board.empty())
+            ImGui::Text("Board: %s", info.board.c_str());
+    }
+    if (!probing(loader, ProbeSection::Cpu, "CPU"))
+        ImGui::Text("CPU: %s - %s @ %sGHz",
+                    info.cpuBrand.c_str(),
+                    info.cpuModel.c_str(),
+                    info.cpuSpeed.c_str());
+    if (!probing(loader, ProbeSection::Gpu, "GPU"))
+        ImGui::Text("GPU: %s", info.gpu.c_str());
+    if (!probing(loader, ProbeSection::Memory, "RAM"))
+    {
+        ImGui::Text("RAM: %s %s",
+                    info.ram.c_str(),
+                    info.memoryType.c_str());
+        for (const auto &m : info.memoryModules)
+        {
+            ImGui::BulletText(
+                "%s: %lu MB %s @ %u MT/s",
+                m.locator.c_str(),
+                m.sizeMB,
+                m.type.c_str(),
+                m.speedMTs);
+        }
+    }
+    if (!probing(loader, ProbeSection::Display, "Screen"))
+    {
+        ImGui::Text("Screen: %s", info.resolution.c_str());
+        ImGui::SameLine();
+        ImGui::Text("(%s)", info.screenSize.c_str());
+        for (const auto &d : info.displays)
+        {
+            ImGui::BulletText(
+                "%s: %s %s %dx%d@%.0fHz, %dx%dmm",
+                d.connector.c_str(),
+                d.vendor.c_str(),
+                d.name.c_str(),
+                d.nativeWidth,
+                d.nativeHeight,
+                d.refreshHz,
+                d.widthMm,
+                d.heightMm);
+        }
+    }
+    if (!probing(loader, ProbeSection::Battery, "Battery"))
+    {
+        if (info.batteryHealth >= 0)
+            ImGui::Text("Battery: %s (%.0f%%)", info.battery.c_str(), info.batteryHealth);
+        else
+            ImGui::Text("Battery: %s", info.battery.c_str());
+        for (const auto &b : info.batteries)
+        {
+            // -1 means the firmware doesn't report the value.
+            char charge[16] = "n/a";
+            char cycles[24] = "n/a";
+            if (b.chargePercent >= 0)
+                std::snprintf(charge, sizeof(charge), "%d%%", b.chargePercent);
+            if (b.cycleCount >= 0)
+                std::snprintf(cycles, sizeof(cycles), "%ld", b.cycleCount);
+            ImGui::BulletText(
+                "%s: %s charged, %s cycles, %s",
+                b.name.c_str(),
+                charge,
+                cycles,
+                b.status.c_str());
+        }
+    }
+
+    if (!info.pciDevices.empty())
+    {
+        ImGui::Separator();
+        ImGui::Text("PCI Devices:");
+        for (const auto &device : info.pciDevices)
+        {
+            ImGui::BulletText("%s", device.c_str());
+        }
+    }
+
+    if (!info.storageTypes.empty())
+    {
+        ImGui::Separator();
+        ImGui::Text("Drive Support:");
+        for (const auto &type : info.storageTypes)
+            ImGui::BulletText("%s", type.c_str());
+    }
+
+    ImGui::Separator();
+    if (!probing(loader, ProbeSection::Drives, "Drives") && !info.detectedDrives.empty())
+    {
+        ImGui::Text("Drives:");
+        for (const auto &d : info.detectedDrives)
+        {
+            ImGui::BulletText(
+                "%s (%s, %s, %s, %.0f GB)",
+                d.name.c_str(),
+                d.tran.c_str(),
+                d.type.c_str(),
+                d.model.c_str(),
+                d.sizeBytes / 1e9);
+        }
+    }
+
+    if (!info.timings.empty() && ImGui::CollapsingHeader("Probes"))
+    {
+        for (const auto &t : info.timings)
+        {
+            if (t.disabled || t.cached)
+                ImGui::BulletText("%s: %s", t.section.c_str(), probeStatus(t));
+            else
+                ImGui::BulletText("%s: %s, %.1f ms", t.section.c_str(), probeStatus(t), t.wallMs);
+        }
+    }
+}
+
 int main(int argc, char *argv[])
 {
     bool windowed = false;
@@ -105,29 +338,83 @@ int main(int argc, char *argv[])
     std::string modalTitle;
     std::string modalMessage;
 
+    int profileRuns = 0;
+    std::string tracePath;
+    std::string jsonPath;
+
     for (int i = 1; i < argc; ++i)
     {
-        if (std::string(argv[i]) == "--windowed")
+        std::string arg = argv[i];
+        if (arg == "--windowed")
             windowed = true;
+        else if (arg == "--probe-profile" && i + 1 < argc)
+            profileRuns = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--json")
+            jsonPath = (i + 1 < argc && argv[i + 1][0] != '-') ? argv[++i] : "-";
+        else if (arg == "--trace")
+            tracePath = (i + 1 < argc && argv[i + 1][0] != '-') ? argv[++i] : "/tmp/debxray-trace.json";
+    }
+
+    if (!tracePath.empty())
+        traceEnable();
+
+    if (profileRuns > 0)
+        return runProbeProfile(profileRuns);
+    if (!jsonPath.empty())
+    {
+        int rc = runHeadless(jsonPath);
+        if (!tracePath.empty())
+            writeTrace(tracePath);
+        return rc;
     }
 
     // ── Clear previous log ──
-    clearLog();
+    {
+        TraceScope t("clearLog");
+        clearLog();
+    }
 
-    if (isOnline())
-        installDependencies();
-    else
-        logMessage("[-] No network connection.");
+    // Reachability runs in the background for the whole session.
+    connectivity.start();
 
+    // Missing tools are installed in the background once the UI is up and
+    // the network is reachable; probes fall back to native sources meanwhile.
+    std::vector<std::string> missingDeps;
+    {
+        TraceScope t("capabilities");
+        logRecord(LogLevel::Info, LogSource::Packages, "Capabilities: " + describeCapabilities());
+        missingDeps = missingDependencies();
+    }
+    DependencyInstaller installer;
+    bool installDeferredLogged = false;
+    if (missingDeps.empty())
+        logRecord(LogLevel::Success, LogSource::Packages, "No missing dependencies.");
+
+    // Probe in the background; the UI fills fields in as sections land.
+    SystemInfo info;
+    SystemInfoLoader sysInfoLoader;
+    sysInfoLoader.start();
+    bool driveGateChecked = false;
+    bool firstFramePresented = false;
+    bool traceWritten = false;
+
+    traceBegin("SDL_Init");
     if (SDL_Init(SDL_INIT_VIDEO) != 0)
     {
-        logMessage("SDL_Init failed: " + std::string(SDL_GetError()));
+        logRecord(LogLevel::Error, LogSource::App, "SDL_Init failed: " + std::string(SDL_GetError()));
+        traceEnd("SDL_Init");
+        if (!tracePath.empty())
+            writeTraceLogged(tracePath);
         return 1;
     }
+    traceEnd("SDL_Init");
 
+    traceBegin("window");
     SDL_Window *window = createWindow(windowed);
     SDL_Renderer *renderer = createRenderer(window);
+    traceEnd("window");
 
+    traceBegin("ImGui init");
     IMGUI_CHECKVERSION();
     ImGui::CreateContext();
     ImGuiIO &io = ImGui::GetIO();
@@ -135,25 +422,57 @@ int main(int argc, char *argv[])
     ImGui::StyleColorsDark();
     ImGui_ImplSDL2_InitForSDLRenderer(window, renderer);
     ImGui_ImplSDLRenderer2_Init(renderer);
+    traceEnd("ImGui init");
 
+    traceBegin("WebcamFeed");
     WebcamFeed webcam(renderer);
-    SystemInfo info = getSystemInfo();
-
-    // if any non-USB drive detected (and not Apple/Surface) → block
-    if (info.hasNonUsbDrives && !isAppleOrSurface(info.model))
-    {
-        logMessage("[-] Internal drive(s) detected.");
-        modalTitle = "Non-USB Drive Detected";
-        modalMessage =
-            "This system has internal (non-USB) drives connected.\n\n"
-            "Please shut down and remove them.";
-        showModal = true;
-    }
+    traceEnd("WebcamFeed");
 
     SDL_Event e;
     bool running = true;
+    bool quitPending = false;   // quit waits for a running install
     while (running)
     {
+        sysInfoLoader.poll(info);
+
+        // ── Background dependency install ──
+        // Held until the link is up: an offline start only defers it.
+        if (!missingDeps.empty())
+        {
+            LinkStatus link = connectivity.status();
+            if (link == LinkStatus::Online)
+            {
+                installer.start(missingDeps);
+                missingDeps.clear();
+            }
+            else if (link == LinkStatus::Offline && !installDeferredLogged)
+            {
+                logRecord(LogLevel::Warning, LogSource::Packages,
+                          "No network connection; dependency install will start once online.");
+                installDeferredLogged = true;
+            }
+        }
+        std::vector<std::string> installedDeps;
+        if (installer.takeFinished(installedDeps))
+            sysInfoLoader.refresh(probeSectionsUsingPackages(installedDeps));
+
+        // if any non-USB drive detected (and not Apple/Surface) → block
+        if (!driveGateChecked &&
+            sysInfoLoader.isReady(ProbeSection::Drives) &&
+            sysInfoLoader.isReady(ProbeSection::Identity))
+        {
+            driveGateChecked = true;
+            if (info.hasNonUsbDrives && !isAppleOrSurface(info.model))
+            {
+                logRecord(LogLevel::Warning, LogSource::Probe, "Internal drive(s) detected.");
+                modalTitle = "Non-USB Drive Detected";
+                modalMessage =
+                    "This system has internal (non-USB) drives connected.\n\n"
+                    "Please shut down and remove them.";
+                showModal = true;
+            }
+        }
+
         while (SDL_PollEvent(&e))
         {
             ImGui_ImplSDL2_ProcessEvent(&e);
@@ -161,7 +480,16 @@ int main(int argc, char *argv[])
             if (e.type == SDL_QUIT ||
                 (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_ESCAPE))
             {
-                running = false;
+                // apt and dpkg die with us (SIGPIPE on their output pipe)
+                // and can leave packages half-configured; let them finish.
+                if (installer.isBusy())
+                {
+                    if (!quitPending)
+                        logRecord(LogLevel::Info, LogSource::Packages, "Quit requested; finishing dependency install first.");
+                    quitPending = true;
+                }
+                else
+                    running = false;
             }
 
             if (e.type == SDL_KEYDOWN)
@@ -171,19 +499,23 @@ int main(int argc, char *argv[])
                 switch (e.key.keysym.sym)
                 {
                 case SDLK_u:
-                    if (ctrl)
+                    if (ctrl && !sysInfoLoader.isComplete())
+                    {
+                        logRecord(LogLevel::Warning, LogSource::Network, "Still probing - upload once System Info is complete.");
+                    }
+                    else if (ctrl)
                     {
                         if (uploadSpecs(toJson(info)))
-                            logMessage("[+] Specs uploaded manually.");
+                            logRecord(LogLevel::Success, LogSource::Network, "Specs uploaded manually.");
                         else
-                            logMessage("[-] Upload Failed Specs, please try again or contact support.");
+                            logRecord(LogLevel::Error, LogSource::Network, "Upload Failed Specs, please try again or contact support.");
                     }
                     break;
 
                 case SDLK_q:
                     if (ctrl)
                     {
-                        logMessage("[*] Shutting down via keyboard...");
+                        logRecord(LogLevel::Info, LogSource::App, "Shutting down via keyboard...");
                         system("sudo shutdown -h now");
                     }
                     break;
@@ -230,26 +562,37 @@ int main(int argc, char *argv[])
         {
             if (ImGui::BeginMenu("System"))
             {
-                if (ImGui::MenuItem("Upload Specs"))
+                if (ImGui::MenuItem("Upload Specs", nullptr, false, sysInfoLoader.isComplete()))
                 {
                     if (uploadSpecs(toJson(info)))
                     {
-                        logMessage("[+] Specs uploaded manually.");
+                        logRecord(LogLevel::Success, LogSource::Network, "Specs uploaded manually.");
                     }
                     else
                     {
-                        logMessage("[-] Upload Failed - please try again or contact support.");
+                        logRecord(LogLevel::Error, LogSource::Network, "Upload Failed - please try again or contact support.");
                     }
                 }
 
                 if (ImGui::MenuItem("Shutdown"))
                 {
-                    logMessage("[*] Shutting down via menu...");
+                    logRecord(LogLevel::Info, LogSource::App, "Shutting down via menu...");
                     //system("sudo shutdown -h now");
                 }
 
                 ImGui::EndMenu();
             }
+
+            // ── Link status, right-aligned ──
+            LinkStatus link = connectivity.status();
+            char linkLabel[32];
+            std::snprintf(linkLabel, sizeof(linkLabel), "Network: %s", linkStatusName(link));
+            ImGui::SameLine(ImGui::GetWindowWidth() - ImGui::CalcTextSize(linkLabel).x - 20.0f);
+            ImGui::TextColored(
+                link == LinkStatus::Online    ? ImVec4(0.2f, 0.8f, 0.2f, 1.0f)
+                : link == LinkStatus::Offline ? ImVec4(0.8f, 0.1f, 0.1f, 1.0f)
+                                              : ImVec4(0.6f, 0.6f, 0.6f, 1.0f),
+                "%s", linkLabel);
             ImGui::EndMenuBar();
         }
 
@@ -265,54 +608,7 @@ int main(int argc, char *argv[])
         ImGui::BeginChild("SystemInfoBox", ImVec2(halfWidth, halfHeight), true);
         ImGui::Text("System Info");
         ImGui::Separator();
-        ImGui::Text("Form Factor: %s", info.isLaptop ? "Laptop" : "Desktop");
-        ImGui::Text("Model: %s", info.model.c_str());
-        ImGui::Text("Serial: %s", info.serial.c_str());
-        ImGui::Text("CPU: %s - %s @ %sGHz",
-                    info.cpuBrand.c_str(),
-                    info.cpuModel.c_str(),
-                    info.cpuSpeed.c_str());
-        ImGui::Text("GPU: %s", info.gpu.c_str());
-        ImGui::Text("RAM: %s %s",
-                    info.ram.c_str(),
-                    info.memoryType.c_str());
-        ImGui::Text("Screen: %s", info.resolution.c_str());
-        ImGui::SameLine();
-        ImGui::Text("(%s)", info.screenSize.c_str());
-        ImGui::Text("Battery: %s", info.battery.c_str());
-
-        if (!info.pciDevices.empty())
-        {
-            ImGui::Separator();
-            ImGui::Text("PCI Devices:");
-            for (const auto &device : info.pciDevices)
-            {
-                ImGui::BulletText("%s", device.c_str());
-            }
-        }
-
-        if (!info.storageTypes.empty())
-        {
-            ImGui::Separator();
-            ImGui::Text("Drive Support:");
-            for (const auto &type : info.storageTypes)
-                ImGui::BulletText("%s", type.c_str());
-        }
-
-        if (!info.detectedDrives.empty())
-        {
-            ImGui::Separator();
-            ImGui::Text("Drives:");
-            for (const auto &d : info.detectedDrives)
-            {
-                ImGui::BulletText(
-                    "%s (%s, %s, %s)",
-                    d.name.c_str(),
-                    d.tran.c_str(),
-                    d.type.c_str(),
-                    d.model.c_str());
-            }
-        }
+        drawSystemInfo(info, sysInfoLoader);
 
         ImGui::EndChild();
         ImGui::EndGroup();
@@ -324,7 +620,12 @@ int main(int argc, char *argv[])
         ImGui::Text("Webcam Preview");
         webcam.update();
 
-        if (webcam.isFailed())
+        if (webcam.isSearching())
+        {
+            ImGui::Spacing();
+            ImGui::TextDisabled("Searching for webcam...");
+        }
+        else if (webcam.isFailed())
         {
             ImGui::Spacing();
             ImGui::TextColored(
@@ -351,14 +652,61 @@ int main(int argc, char *argv[])
         ImGui::BeginGroup(); // ── Bottom-Left: Logs ──
         ImGui::BeginChild("LogViewerBox", ImVec2(halfWidth, halfHeight - 5), true);
         ImGui::Text("Logs");
+        static LogFilter logFilter;
+        static int logSource = -1; // -1: all sources
+        static LogView logView;
+        static char logSearch[128] = "";
+        for (unsigned l = 0; l < static_cast<unsigned>(LogLevel::Count); ++l)
+        {
+            bool on = (logFilter.levels >> l) & 1u;
+            ImGui::SameLine();
+            if (ImGui::Checkbox(logLevelName(static_cast<LogLevel>(l)), &on))
+            {
+                logFilter.levels ^= 1u << l;
+                logView.setFilter(logFilter);
+            }
+        }
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(110.0f);
+        if (ImGui::BeginCombo("##LogSource", logSource < 0 ? "all sources" : logSourceName(static_cast<LogSource>(logSource))))
+        {
+            for (int src = -1; src < static_cast<int>(LogSource::Count); ++src)
+            {
+                const char *label = src < 0 ? "all sources" : logSourceName(static_cast<LogSource>(src));
+                if (ImGui::Selectable(label, src == logSource))
+                {
+                    logSource = src;
+                    logFilter.sources = src < 0 ? ~0u : 1u << src;
+                    logView.setFilter(logFilter);
+                }
+            }
+            ImGui::EndCombo();
+        }
+        ImGui::SetNextItemWidth(-FLT_MIN);
+        if (ImGui::InputTextWithHint("##LogSearch", "Search logs", logSearch, sizeof(logSearch)))
+            logView.setQuery(logSearch);
+        logView.update();
+        if (logSearch[0])
+            ImGui::TextDisabled("%zu of %zu lines match", logView.size(), logView.totalLines());
+        if (installer.isBusy())
+        {
+            std::string action = installer.action();
+            ImGui::ProgressBar(installer.progress(), ImVec2(-1.0f, 0.0f), action.c_str());
+        }
         ImGui::Separator();
         ImGui::BeginChild(
             "LogScroll", ImVec2(0, 0), false,
             ImGuiWindowFlags_AlwaysVerticalScrollbar);
-        auto logs = readLogTail(100);
-        for (const auto &line : logs)
+        // Only the rows in view are copied and submitted, however long
+        // the session's log has grown.
+        static std::vector<std::string> visibleLogs;
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(logView.size()));
+        while (clipper.Step())
         {
-            ImGui::TextUnformatted(line.c_str());
+            logView.copyRows(clipper.DisplayStart, clipper.DisplayEnd, visibleLogs);
+            for (const auto &line : visibleLogs)
+                ImGui::TextUnformatted(line.data(), line.data() + line.size());
         }
         if (ImGui::GetScrollY() >= ImGui::GetScrollMaxY() - 5.0f)
             ImGui::SetScrollHereY(1.0f);
@@ -492,22 +840,78 @@ int main(int argc, char *argv[])
             {
                 showModal = false;
 
-                if (info.detectedDrives.empty())
+                if (info.detectedDrives.empty() && sysInfoLoader.isComplete())
                 {
                     if (uploadSpecs(toJson(info)))
-                        logMessage("[+] Specs uploaded successfully.");
+                        logRecord(LogLevel::Success, LogSource::Network, "Specs uploaded successfully.");
                     else
-                        logMessage("[+] Upload Failed — please try again or contact support.");
+                        logRecord(LogLevel::Error, LogSource::Network, "Upload Failed — please try again or contact support.");
                 }
             }
         }
 
+        //
+        // ── Finishing install (quit requested while apt runs) ──
+        //
+        if (quitPending)
+        {
+            ImGui::SetNextWindowPos(ImVec2(0, 0));
+            ImGui::SetNextWindowSize(io.DisplaySize);
+            ImGui::Begin(
+                "FinishingInstall", nullptr,
+                ImGuiWindowFlags_NoDecoration |
+                    ImGuiWindowFlags_NoMove |
+                    ImGuiWindowFlags_NoResize |
+                    ImGuiWindowFlags_NoCollapse |
+                    ImGuiWindowFlags_NoTitleBar);
+
+            ImVec2 center = ImVec2(io.DisplaySize.x * 0.5f, io.DisplaySize.y * 0.5f);
+            ImGui::SetCursorPos(ImVec2(center.x - 150, center.y - 50));
+
+            ImGui::BeginGroup();
+            ImGui::Text("Finishing dependency install...");
+            ImGui::Spacing();
+            ImGui::PushTextWrapPos(ImGui::GetCursorPosX() + 300.0f);
+            ImGui::TextUnformatted("debXray will close once apt is done.");
+            ImGui::PopTextWrapPos();
+            std::string action = installer.action();
+            ImGui::ProgressBar(installer.progress(), ImVec2(300.0f, 0.0f), action.c_str());
+            ImGui::EndGroup();
+            ImGui::End();
+
+            if (!installer.isBusy())
+                running = false;
+        }
+
         // ── Render Normal UI ──
         ImGui::Render();
         SDL_SetRenderDrawColor(renderer, 30, 30, 30, 255);
         SDL_RenderClear(renderer);
         ImGui_ImplSDLRenderer2_RenderDrawData(ImGui::GetDrawData(), renderer);
         SDL_RenderPresent(renderer);
+
+        if (!firstFramePresented)
+        {
+            firstFramePresented = true;
+            traceInstant("first frame presented");
+        }
+
+        // Boot-to-ready is what the trace is for; write it as soon as the
+        // snapshot is complete rather than waiting for exit.
+        if (!tracePath.empty() && !traceWritten && sysInfoLoader.isComplete())
+        {
+            traceWritten = true;
+            traceInstant("system info complete");
+            writeTraceLogged(tracePath);
+        }
+    }
+
+    // Quit before the snapshot completed: the partial trace is exactly
+    // what shows where boot stalled.
+    if (!tracePath.empty() && !traceWritten)
+    {
+        traceInstant("shutdown");
+        writeTraceLogged(tracePath);
     }
 
     // ── Cleanup ──